@@ -0,0 +1,309 @@
+/**
+ * Benchmarks of the hot paths of the master problem
+ *
+ * All the benchmarks run on the synthetic set partitioning models of the
+ * examples (see '../examples/pricingsolver/set_partitioning.hpp'), so that
+ * they don't need any external data. Their arguments are the number of rows
+ * and the number of columns of the model.
+ *
+ * The construction of the master LP is internal to 'column_generation' and
+ * is measured through calls capped to a single iteration. The scan of the
+ * column pool and the computation of the separation point of the
+ * stabilization are measured through the functions 'column_generation'
+ * calls, 'scan_column_pool' and 'compute_separation_point', and the
+ * stabilization also through full runs with each stabilization enabled.
+ *
+ */
+
+#include "pricingsolver/set_partitioning.hpp"
+
+#include "columngenerationsolver/algorithms/column_generation.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace columngenerationsolver;
+using namespace columngenerationsolver::set_partitioning;
+
+namespace
+{
+
+SolverName benchmark_solver_name()
+{
+#if CLP_FOUND
+    return SolverName::CLP;
+#elif HIGHS_FOUND
+    return SolverName::Highs;
+#elif CPLEX_FOUND
+    return SolverName::CPLEX;
+#elif XPRESS_FOUND
+    return SolverName::Xpress;
+#else
+    return SolverName::CLP;
+#endif
+}
+
+SetPartitioningParameters benchmark_parameters(
+        const benchmark::State& state)
+{
+    SetPartitioningParameters parameters;
+    parameters.number_of_rows = state.range(0);
+    parameters.number_of_columns = state.range(1);
+    return parameters;
+}
+
+ColumnGenerationParameters benchmark_column_generation_parameters()
+{
+    ColumnGenerationParameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.solver_name = benchmark_solver_name();
+    return parameters;
+}
+
+std::vector<Value> random_duals(
+        RowIdx number_of_rows,
+        Counter seed)
+{
+    std::mt19937_64 generator(seed);
+    std::uniform_real_distribution<Value> distribution(0.0, 2.0);
+    std::vector<Value> duals(number_of_rows);
+    for (Value& dual: duals)
+        dual = distribution(generator);
+    return duals;
+}
+
+void model_arguments(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({"rows", "columns"});
+    for (RowIdx number_of_rows: {100, 1000})
+        for (ColIdx number_of_columns: {1000, 10000, 100000})
+            benchmark->Args({number_of_rows, number_of_columns});
+}
+
+void column_generation_arguments(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({"rows", "columns"});
+    benchmark->Args({50, 1000});
+    benchmark->Args({100, 5000});
+    benchmark->Args({200, 20000});
+    benchmark->Unit(benchmark::kMillisecond);
+}
+
+}
+
+/**
+ * Construction of the master LP: a single iteration of 'column_generation'
+ * with all the columns of the model given as initial columns.
+ */
+void BM_MasterConstruction(benchmark::State& state)
+{
+    SetPartitioningParameters sp_parameters = benchmark_parameters(state);
+    Model model = generate_set_partitioning_model(sp_parameters);
+    std::vector<std::shared_ptr<const Column>> columns
+        = generate_set_partitioning_columns(sp_parameters);
+    for (auto _: state) {
+        ColumnGenerationParameters parameters = benchmark_column_generation_parameters();
+        parameters.maximum_number_of_iterations = 1;
+        parameters.initial_columns = columns;
+        ColumnGenerationOutput output = column_generation(model, parameters);
+        benchmark::DoNotOptimize(output.relaxation_solution_value);
+    }
+    state.SetItemsProcessed(state.iterations() * columns.size());
+}
+BENCHMARK(BM_MasterConstruction)
+    ->ArgNames({"rows", "columns"})
+    ->Args({100, 1000})
+    ->Args({100, 10000})
+    ->Args({1000, 10000})
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * Scan of a column pool for improving columns with 'scan_column_pool', as
+ * done before calling the pricing solver, every column being a candidate.
+ */
+void BM_ColumnPoolReducedCostScan(benchmark::State& state)
+{
+    SetPartitioningParameters sp_parameters = benchmark_parameters(state);
+    Model model = generate_set_partitioning_model(sp_parameters);
+    ColumnPool column_pool(model, generate_set_partitioning_columns(sp_parameters));
+    std::vector<Value> duals = random_duals(sp_parameters.number_of_rows, 1);
+    ColumnGenerationParameters parameters;
+    std::vector<std::shared_ptr<const Column>> new_columns;
+    for (auto _: state) {
+        new_columns.clear();
+        scan_column_pool(
+                model,
+                column_pool,
+                false,
+                duals,
+                {},
+                parameters.optimality_tolerance,
+                [](ColIdx, const std::shared_ptr<const Column>&) { return true; },
+                new_columns);
+        benchmark::DoNotOptimize(new_columns.data());
+    }
+    state.SetItemsProcessed(state.iterations() * column_pool.number_of_columns());
+}
+BENCHMARK(BM_ColumnPoolReducedCostScan)->Apply(model_arguments);
+
+/**
+ * Insertion of columns in a 'ColumnPool', i.e. in a hash map using
+ * 'ColumnHasher'. The second half of the columns are copies of the first
+ * half, so that half of the insertions hit an existing column.
+ */
+void BM_ColumnHasherInsert(benchmark::State& state)
+{
+    SetPartitioningParameters sp_parameters = benchmark_parameters(state);
+    Model model = generate_set_partitioning_model(sp_parameters);
+    std::vector<std::shared_ptr<const Column>> columns
+        = generate_set_partitioning_columns(sp_parameters);
+    ColIdx number_of_distinct_columns = columns.size();
+    for (ColIdx column_id = 0;
+            column_id < number_of_distinct_columns;
+            ++column_id) {
+        columns.push_back(std::make_shared<Column>(*columns[column_id]));
+    }
+    for (auto _: state) {
+        ColumnPool column_pool(model);
+        for (const auto& column: columns)
+            column_pool.add(column);
+        benchmark::DoNotOptimize(column_pool.number_of_columns());
+    }
+    state.SetItemsProcessed(state.iterations() * columns.size());
+}
+BENCHMARK(BM_ColumnHasherInsert)->Apply(model_arguments);
+
+/**
+ * Lookup of columns in a 'ColumnPool'. Half of the columns looked up are
+ * copies of columns of the pool, the other half are not in the pool.
+ */
+void BM_ColumnHasherLookup(benchmark::State& state)
+{
+    SetPartitioningParameters sp_parameters = benchmark_parameters(state);
+    Model model = generate_set_partitioning_model(sp_parameters);
+    std::vector<std::shared_ptr<const Column>> columns
+        = generate_set_partitioning_columns(sp_parameters);
+    ColumnPool column_pool(model);
+    std::vector<std::shared_ptr<const Column>> lookups;
+    for (ColIdx column_id = 0;
+            column_id < (ColIdx)columns.size();
+            ++column_id) {
+        if (column_id % 2 == 0) {
+            column_pool.add(columns[column_id]);
+            lookups.push_back(std::make_shared<Column>(*columns[column_id]));
+        } else {
+            lookups.push_back(columns[column_id]);
+        }
+    }
+    for (auto _: state) {
+        ColIdx number_of_hits = 0;
+        for (const auto& column: lookups)
+            if (column_pool.contains(column))
+                number_of_hits++;
+        benchmark::DoNotOptimize(number_of_hits);
+    }
+    state.SetItemsProcessed(state.iterations() * lookups.size());
+}
+BENCHMARK(BM_ColumnHasherLookup)->Apply(model_arguments);
+
+/**
+ * 'SolutionBuilder::build' of a fractional solution using all the columns
+ * of the model.
+ */
+void BM_SolutionBuilderBuild(benchmark::State& state)
+{
+    SetPartitioningParameters sp_parameters = benchmark_parameters(state);
+    Model model = generate_set_partitioning_model(sp_parameters);
+    std::vector<std::shared_ptr<const Column>> columns
+        = generate_set_partitioning_columns(sp_parameters);
+    Value value = 1.0 / sp_parameters.number_of_partitions;
+    for (auto _: state) {
+        SolutionBuilder solution_builder;
+        solution_builder.set_model(model);
+        for (const auto& column: columns)
+            solution_builder.add_column(column, value);
+        Solution solution = solution_builder.build();
+        benchmark::DoNotOptimize(solution.objective_value());
+    }
+    state.SetItemsProcessed(state.iterations() * columns.size());
+}
+BENCHMARK(BM_SolutionBuilderBuild)->Apply(model_arguments);
+
+/**
+ * Computation of the separation point of the stabilization with
+ * 'compute_separation_point', with Wentges smoothing (range(1) == 0) or
+ * with automatic directional smoothing (range(1) == 1), on all the rows.
+ */
+void BM_StabilizationUpdate(benchmark::State& state)
+{
+    RowIdx number_of_rows = state.range(0);
+    bool directional_smoothing = state.range(1);
+    std::vector<RowIdx> rows(number_of_rows);
+    std::iota(rows.begin(), rows.end(), 0);
+    std::vector<Value> duals_in = random_duals(number_of_rows, 1);
+    std::vector<Value> duals_out = random_duals(number_of_rows, 2);
+    std::vector<Value> subgradient = random_duals(number_of_rows, 3);
+    std::vector<Value> duals_sep(number_of_rows, 0.0);
+    SeparationPointWorkspace workspace;
+    for (auto _: state) {
+        Value beta = compute_separation_point(
+                rows,
+                duals_in,
+                duals_out,
+                subgradient,
+                0.5,
+                directional_smoothing,
+                true,
+                0.0,
+                workspace,
+                duals_sep);
+        benchmark::DoNotOptimize(beta);
+        benchmark::DoNotOptimize(duals_sep.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * number_of_rows);
+}
+BENCHMARK(BM_StabilizationUpdate)
+    ->ArgNames({"rows", "directional"})
+    ->ArgsProduct({{100, 1000, 10000}, {0, 1}});
+
+/**
+ * Full column generation run with the mock pricing solver, without
+ * stabilization.
+ */
+void BM_ColumnGeneration(benchmark::State& state)
+{
+    SetPartitioningParameters sp_parameters = benchmark_parameters(state);
+    Model model = generate_set_partitioning_model(sp_parameters);
+    Counter number_of_iterations = 0;
+    for (auto _: state) {
+        ColumnGenerationParameters parameters = benchmark_column_generation_parameters();
+        ColumnGenerationOutput output = column_generation(model, parameters);
+        number_of_iterations = output.number_of_column_generation_iterations;
+        benchmark::DoNotOptimize(output.relaxation_solution_value);
+    }
+    state.counters["iterations"] = number_of_iterations;
+}
+BENCHMARK(BM_ColumnGeneration)->Apply(column_generation_arguments);
+
+/**
+ * Full column generation run with the mock pricing solver, with
+ * self-adjusting Wentges smoothing and automatic directional smoothing.
+ */
+void BM_ColumnGenerationStabilized(benchmark::State& state)
+{
+    SetPartitioningParameters sp_parameters = benchmark_parameters(state);
+    Model model = generate_set_partitioning_model(sp_parameters);
+    Counter number_of_iterations = 0;
+    for (auto _: state) {
+        ColumnGenerationParameters parameters = benchmark_column_generation_parameters();
+        parameters.self_adjusting_wentges_smoothing = true;
+        parameters.automatic_directional_smoothing = true;
+        ColumnGenerationOutput output = column_generation(model, parameters);
+        number_of_iterations = output.number_of_column_generation_iterations;
+        benchmark::DoNotOptimize(output.relaxation_solution_value);
+    }
+    state.counters["iterations"] = number_of_iterations;
+}
+BENCHMARK(BM_ColumnGenerationStabilized)->Apply(column_generation_arguments);
+
+BENCHMARK_MAIN();
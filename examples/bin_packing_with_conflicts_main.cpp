@@ -67,7 +67,8 @@ public:
             bool solve_feasibility,
             const std::vector<Value>& duals,
             const std::vector<std::pair<std::shared_ptr<const columngenerationsolver::Cut>, Value>>& cut_duals,
-            columngenerationsolver::Counter pricing_level);
+            columngenerationsolver::Counter pricing_level,
+            const columngenerationsolver::PricingContext& context);
 
 private:
 
@@ -127,7 +128,8 @@ PricingSolver::PricingOutput PricingSolver::solve_pricing(
             bool,
             const std::vector<Value>& duals,
             const std::vector<std::pair<std::shared_ptr<const columngenerationsolver::Cut>, Value>>&,
-            columngenerationsolver::Counter)
+            columngenerationsolver::Counter,
+            const columngenerationsolver::PricingContext& context)
 {
     PricingOutput output;
 
@@ -159,8 +161,10 @@ PricingSolver::PricingOutput PricingSolver::solve_pricing(
     kp_parameters.maximum_size_of_the_solution_pool = 1;
     kp_parameters.minimum_size_of_the_queue = bs_size_of_the_queue_;
     kp_parameters.maximum_size_of_the_queue = bs_size_of_the_queue_;
+    branching_scheme.set_pricing_context(&context);
     auto kp_output = treesearchsolver::iterative_beam_search(
             branching_scheme, kp_parameters);
+    output.interrupted = context.needs_to_end();
 
     // Retrieve column.
     for (const std::shared_ptr<Node>& node: kp_output.solution_pool.solutions()) {
@@ -228,6 +232,7 @@ int main(int argc, char *argv[])
 
     // Create model.
     columngenerationsolver::Model model = get_model(instance);
+    columngenerationsolver::read_pricing_solver_args(model, vm);
 
     // Solve.
     auto output = run(model, write_solution, vm);
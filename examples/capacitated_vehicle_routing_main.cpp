@@ -41,6 +41,8 @@
 
 #include "optimizationtools/utils/utils.hpp"
 
+#include <cstring>
+
 using namespace orproblems::capacitated_vehicle_routing;
 
 using Value = columngenerationsolver::Value;
@@ -70,7 +72,8 @@ public:
             bool solve_feasibility,
             const std::vector<Value>& duals,
             const std::vector<std::pair<std::shared_ptr<const columngenerationsolver::Cut>, Value>>& cut_duals,
-            columngenerationsolver::Counter pricing_level);
+            columngenerationsolver::Counter pricing_level,
+            const columngenerationsolver::PricingContext& context);
 
     void set_beam_search_size_of_the_queue(treesearchsolver::NodeId bs_size_of_the_queue) { bs_size_of_the_queue_ = bs_size_of_the_queue; }
 
@@ -159,7 +162,8 @@ typename PricingSolver<Distances>::PricingOutput PricingSolver<Distances>::solve
             bool solve_feasibility,
             const std::vector<Value>& duals,
             const std::vector<std::pair<std::shared_ptr<const columngenerationsolver::Cut>, Value>>&,
-            columngenerationsolver::Counter)
+            columngenerationsolver::Counter,
+            const columngenerationsolver::PricingContext& context)
 {
     PricingOutput output;
 
@@ -209,8 +213,10 @@ typename PricingSolver<Distances>::PricingOutput PricingSolver<Distances>::solve
     espp_parameters.minimum_size_of_the_queue = bs_size_of_the_queue_;
     espp_parameters.maximum_size_of_the_queue = bs_size_of_the_queue_;
     espp_parameters.verbosity_level = 0;
+    branching_scheme.set_pricing_context(&context);
     auto espp_output = treesearchsolver::iterative_beam_search(
             branching_scheme, espp_parameters);
+    output.interrupted = context.needs_to_end();
 
     // Retrieve column.
     for (const std::shared_ptr<columngenerationsolver::espprc::BranchingScheme::Node>& node:
@@ -265,6 +271,28 @@ inline void write_solution(
     }
 }
 
+std::string serialize_column_extra(
+        const columngenerationsolver::Column& column)
+{
+    if (column.extra == nullptr)
+        return "";
+    std::shared_ptr<ColumnExtra> extra
+        = std::static_pointer_cast<ColumnExtra>(column.extra);
+    return std::string(
+            (const char*)extra->route.data(),
+            extra->route.size() * sizeof(LocationId));
+}
+
+std::shared_ptr<void> deserialize_column_extra(
+        const char* data,
+        size_t size)
+{
+    ColumnExtra extra;
+    extra.route.resize(size / sizeof(LocationId));
+    std::memcpy(extra.route.data(), data, size);
+    return std::shared_ptr<void>(new ColumnExtra(extra));
+}
+
 int main(int argc, char *argv[])
 {
     // Setup options.
@@ -297,9 +325,17 @@ int main(int argc, char *argv[])
             get_model,
             instance.distances(),
             instance);
+    columngenerationsolver::read_pricing_solver_args(model, vm);
 
     // Solve.
-    auto output = run(model, write_solution, vm);
+    auto output = run(
+            model,
+            write_solution,
+            vm,
+            {},
+            {},
+            serialize_column_extra,
+            deserialize_column_extra);
 
     // Run checker.
     if (vm.count("certificate")
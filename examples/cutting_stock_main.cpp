@@ -28,6 +28,15 @@
  * Therefore, finding a variable of minimum reduced cost reduces to solving
  * a Bounded Knapsack Problem with items with profit vⱼ.
  *
+ * With option '--greedy-pricing 1', the pricing problem has two levels: a
+ * greedy heuristic (level 0), then the exact algorithm (level 1).
+ *
+ * Dual-optimal inequalities:
+ * vⱼ₁ >= vⱼ₂ for all item types j₁, j₂ such that wⱼ₁ >= wⱼ₂
+ * In a pattern, a copy of j₁ can always be replaced by a copy of j₂, so there
+ * is an optimal dual solution satisfying them. Only the ones between item
+ * types consecutive by weight are added, the others follow.
+ *
  */
 
 #include "read_args.hpp"
@@ -40,6 +49,8 @@
 #include "knapsacksolver/algorithms/dynamic_programming_bellman.hpp"
 #include "knapsacksolver/algorithms/dynamic_programming_primal_dual.hpp"
 
+#include <numeric>
+
 using namespace orproblems::cutting_stock;
 
 using Value = columngenerationsolver::Value;
@@ -51,8 +62,11 @@ class PricingSolver: public columngenerationsolver::PricingSolver
 
 public:
 
-    PricingSolver(const Instance& instance):
+    PricingSolver(
+            const Instance& instance,
+            bool greedy_pricing):
         instance_(instance),
+        greedy_pricing_(greedy_pricing),
         filled_demands_(instance.number_of_item_types())
     { }
 
@@ -61,23 +75,45 @@ public:
             const std::vector<std::shared_ptr<const columngenerationsolver::Cut>>& cuts,
             const std::vector<std::shared_ptr<const columngenerationsolver::BranchingDecision>>& branching_decisions);
 
+    inline virtual columngenerationsolver::Counter number_of_pricing_levels() const
+    {
+        return (greedy_pricing_)? 2: 1;
+    }
+
+    inline virtual bool supports_concurrent_pricing_levels() const
+    {
+        return true;
+    }
+
     inline virtual PricingOutput solve_pricing(
             bool solve_feasibility,
             const std::vector<Value>& duals,
             const std::vector<std::pair<std::shared_ptr<const columngenerationsolver::Cut>, Value>>& cut_duals,
-            columngenerationsolver::Counter pricing_level);
+            columngenerationsolver::Counter pricing_level,
+            const columngenerationsolver::PricingContext& context);
 
 private:
 
+    /**
+     * Fill a bin greedily with the item types of positive profit, by
+     * non-increasing profit per unit of weight.
+     */
+    inline PricingOutput solve_pricing_greedy(
+            bool solve_feasibility,
+            const std::vector<Value>& duals) const;
+
     const Instance& instance_;
 
-    std::vector<Demand> filled_demands_;
+    /** 'true' iff the greedy heuristic is the first pricing level. */
+    bool greedy_pricing_;
 
-    std::vector<ItemTypeId> kp2csp_;
+    std::vector<Demand> filled_demands_;
 
 };
 
-inline columngenerationsolver::Model get_model(const Instance& instance)
+inline columngenerationsolver::Model get_model(
+        const Instance& instance,
+        bool greedy_pricing)
 {
     columngenerationsolver::Model model;
 
@@ -96,9 +132,34 @@ inline columngenerationsolver::Model get_model(const Instance& instance)
         model.rows.push_back(row);
     }
 
+    // Dual-optimal inequalities.
+    std::vector<ItemTypeId> sorted_item_type_ids(instance.number_of_item_types());
+    std::iota(sorted_item_type_ids.begin(), sorted_item_type_ids.end(), 0);
+    std::sort(
+            sorted_item_type_ids.begin(),
+            sorted_item_type_ids.end(),
+            [&instance](
+                ItemTypeId item_type_id_1,
+                ItemTypeId item_type_id_2)
+            {
+                return instance.item_type(item_type_id_1).weight
+                    < instance.item_type(item_type_id_2).weight;
+            });
+    for (ItemTypeId pos = 0;
+            pos + 1 < instance.number_of_item_types();
+            ++pos) {
+        columngenerationsolver::Column column;
+        column.objective_coefficient = 0;
+        column.elements.push_back({sorted_item_type_ids[pos], +1});
+        column.elements.push_back({sorted_item_type_ids[pos + 1], -1});
+        model.dual_optimal_inequalities.push_back(
+                std::shared_ptr<const columngenerationsolver::Column>(
+                    new columngenerationsolver::Column(column)));
+    }
+
     // Pricing solver.
     model.pricing_solver = std::unique_ptr<columngenerationsolver::PricingSolver>(
-            new PricingSolver(instance));
+            new PricingSolver(instance, greedy_pricing));
 
     return model;
 }
@@ -124,13 +185,18 @@ PricingSolver::PricingOutput PricingSolver::solve_pricing(
             bool solve_feasibility,
             const std::vector<Value>& duals,
             const std::vector<std::pair<std::shared_ptr<const columngenerationsolver::Cut>, Value>>&,
-            columngenerationsolver::Counter)
+            columngenerationsolver::Counter pricing_level,
+            const columngenerationsolver::PricingContext&)
 {
+    if (greedy_pricing_ && pricing_level == 0)
+        return solve_pricing_greedy(solve_feasibility, duals);
+
     PricingOutput output;
     Value reduced_cost_bound = 0.0;
 
     // Build subproblem instance.
-    kp2csp_.clear();
+    // Local, since the pricing levels may be solved concurrently.
+    std::vector<ItemTypeId> kp2csp;
     knapsacksolver::InstanceFromFloatProfitsBuilder kp_instance_builder;
     for (ItemTypeId item_type_id = 0;
             item_type_id < instance_.number_of_item_types();
@@ -143,7 +209,7 @@ PricingSolver::PricingOutput PricingSolver::solve_pricing(
                 q < item_type.demand;
                 ++q) {
             kp_instance_builder.add_item(profit, item_type.weight);
-            kp2csp_.push_back(item_type_id);
+            kp2csp.push_back(item_type_id);
         }
     }
     kp_instance_builder.set_capacity(instance_.capacity());
@@ -173,7 +239,7 @@ PricingSolver::PricingOutput PricingSolver::solve_pricing(
             kp_item_id < kp_instance.number_of_items();
             ++kp_item_id) {
         if (kp_output.solution.contains(kp_item_id))
-            demands[kp2csp_[kp_item_id]]++;
+            demands[kp2csp[kp_item_id]]++;
     }
     for (ItemTypeId item_type_id = 0;
             item_type_id < instance_.number_of_item_types();
@@ -190,6 +256,56 @@ PricingSolver::PricingOutput PricingSolver::solve_pricing(
     return output;
 }
 
+PricingSolver::PricingOutput PricingSolver::solve_pricing_greedy(
+            bool solve_feasibility,
+            const std::vector<Value>& duals) const
+{
+    std::vector<ItemTypeId> sorted_item_type_ids;
+    for (ItemTypeId item_type_id = 0;
+            item_type_id < instance_.number_of_item_types();
+            ++item_type_id) {
+        if (duals[item_type_id] > 0
+                && filled_demands_[item_type_id] < instance_.item_type(item_type_id).demand) {
+            sorted_item_type_ids.push_back(item_type_id);
+        }
+    }
+    std::sort(
+            sorted_item_type_ids.begin(),
+            sorted_item_type_ids.end(),
+            [this, &duals](
+                ItemTypeId item_type_id_1,
+                ItemTypeId item_type_id_2)
+            {
+                return duals[item_type_id_1] * instance_.item_type(item_type_id_2).weight
+                    > duals[item_type_id_2] * instance_.item_type(item_type_id_1).weight;
+            });
+
+    columngenerationsolver::Column column;
+    column.objective_coefficient = 1;
+    Weight remaining_capacity = instance_.capacity();
+    for (ItemTypeId item_type_id: sorted_item_type_ids) {
+        const ItemType& item_type = instance_.item_type(item_type_id);
+        Demand number_of_copies = (std::min)(
+                (Demand)(item_type.demand - filled_demands_[item_type_id]),
+                (Demand)(remaining_capacity / item_type.weight));
+        if (number_of_copies <= 0)
+            continue;
+        columngenerationsolver::LinearTerm element;
+        element.row = item_type_id;
+        element.coefficient = number_of_copies;
+        column.elements.push_back(element);
+        remaining_capacity -= number_of_copies * item_type.weight;
+    }
+
+    // Heuristic: 'overcost' is left at its default, no bound.
+    PricingOutput output;
+    if (!column.elements.empty()
+            && compute_reduced_cost(solve_feasibility, column, duals) < 0) {
+        output.columns.push_back(std::shared_ptr<const columngenerationsolver::Column>(new columngenerationsolver::Column(column)));
+    }
+    return output;
+}
+
 inline void write_solution(
         const columngenerationsolver::Solution& solution,
         const std::string& certificate_path)
@@ -219,7 +335,7 @@ int main(int argc, char *argv[])
     // Setup options.
     boost::program_options::options_description desc = columngenerationsolver::setup_args();
     desc.add_options()
-        //("guide,g", boost::program_options::value<GuideId>(), "")
+        ("greedy-pricing", boost::program_options::value<bool>()->default_value(false), "solve the pricing problem with a greedy heuristic before solving it exactly")
         ;
     boost::program_options::variables_map vm;
     boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc), vm);
@@ -242,7 +358,10 @@ int main(int argc, char *argv[])
     const Instance instance = instance_builder.build();
 
     // Create model.
-    columngenerationsolver::Model model = get_model(instance);
+    columngenerationsolver::Model model = get_model(
+            instance,
+            vm["greedy-pricing"].as<bool>());
+    columngenerationsolver::read_pricing_solver_args(model, vm);
 
     // Solve.
     auto output = run(model, write_solution, vm);
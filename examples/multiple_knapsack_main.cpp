@@ -69,7 +69,8 @@ public:
             bool solve_feasibility,
             const std::vector<Value>& duals,
             const std::vector<std::pair<std::shared_ptr<const columngenerationsolver::Cut>, Value>>& cut_duals,
-            columngenerationsolver::Counter pricing_level);
+            columngenerationsolver::Counter pricing_level,
+            const columngenerationsolver::PricingContext& context);
 
 private:
 
@@ -149,7 +150,8 @@ PricingSolver::PricingOutput PricingSolver::solve_pricing(
             bool solve_feasibility,
             const std::vector<Value>& duals,
             const std::vector<std::pair<std::shared_ptr<const columngenerationsolver::Cut>, Value>>&,
-            columngenerationsolver::Counter)
+            columngenerationsolver::Counter,
+            const columngenerationsolver::PricingContext&)
 {
     PricingOutput output;
     Value reduced_cost_bound = 0.0;
@@ -284,6 +286,7 @@ int main(int argc, char *argv[])
 
     // Create model.
     columngenerationsolver::Model model = get_model(instance);
+    columngenerationsolver::read_pricing_solver_args(model, vm);
 
     // Solve.
     auto output = run(
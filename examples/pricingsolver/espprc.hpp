@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include "columngenerationsolver/commons.hpp"
+
 #include "optimizationtools/utils/utils.hpp"
 #include "optimizationtools/containers//sorted_on_demand_array.hpp"
 
@@ -232,11 +234,22 @@ public:
         return r;
     }
 
+    /**
+     * Set the context of the pricing call the search is run for: once it
+     * needs to end, no more child is generated, so that the search returns
+     * the best solutions found so far.
+     */
+    void set_pricing_context(const PricingContext* pricing_context) { pricing_context_ = pricing_context; }
+
     inline std::shared_ptr<Node> next_child(
             const std::shared_ptr<Node>& parent) const
     {
         assert(!infertile(parent));
         assert(!leaf(parent));
+        if (pricing_context_ != nullptr && pricing_context_->needs_to_end()) {
+            parent->guide = std::numeric_limits<double>::max();
+            return nullptr;
+        }
         LocationId next_location_id = neighbor(parent->last_location_id, parent->next_child_pos);
         Distance d = instance_.distance(parent->last_location_id, next_location_id);
         // Update parent
@@ -403,6 +416,9 @@ private:
 
     mutable treesearchsolver::NodeId node_id_ = 0;
 
+    /** Context of the pricing call. */
+    const PricingContext* pricing_context_ = nullptr;
+
 };
 
 }
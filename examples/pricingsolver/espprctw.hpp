@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include "columngenerationsolver/commons.hpp"
+
 #include "treesearchsolver/common.hpp"
 
 #include "boost/dynamic_bitset.hpp"
@@ -112,6 +114,17 @@ public:
     /** Get the capacity of the vehicle. */
     inline Demand capacity() const { return locations_[0].demand; }
 
+    /**
+     * Set the profit of a location, to update an instance in place when
+     * only the duals of the pricing problem change.
+     */
+    void set_location_profit(
+            LocationId location_id,
+            Profit profit)
+    {
+        locations_[location_id].profit = profit;
+    }
+
     /*
      * Outputs
      */
@@ -351,11 +364,22 @@ public:
         return r;
     }
 
+    /**
+     * Set the context of the pricing call the search is run for: once it
+     * needs to end, no more child is generated, so that the search returns
+     * the best solutions found so far.
+     */
+    void set_pricing_context(const PricingContext* pricing_context) { pricing_context_ = pricing_context; }
+
     inline std::shared_ptr<Node> next_child(
             const std::shared_ptr<Node>& parent) const
     {
         assert(!infertile(parent));
         assert(!leaf(parent));
+        if (pricing_context_ != nullptr && pricing_context_->needs_to_end()) {
+            parent->next_child_pos = instance_.number_of_locations();
+            return nullptr;
+        }
         LocationId next_location_id = parent->next_child_pos;
         const Location& location = instance_.location(next_location_id);
         // Update parent
@@ -541,6 +565,9 @@ private:
 
     mutable treesearchsolver::NodeId node_id_ = 0;
 
+    /** Context of the pricing call. */
+    const PricingContext* pricing_context_ = nullptr;
+
 };
 
 }
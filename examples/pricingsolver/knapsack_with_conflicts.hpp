@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include "columngenerationsolver/commons.hpp"
+
 #include "orproblems/packing/knapsack_with_conflicts.hpp"
 
 #include <memory>
@@ -104,9 +106,21 @@ public:
         return r;
     }
 
+    /**
+     * Set the context of the pricing call the search is run for: once it
+     * needs to end, no more child is generated, so that the search returns
+     * the best solutions found so far.
+     */
+    void set_pricing_context(const PricingContext* pricing_context) { pricing_context_ = pricing_context; }
+
     inline std::shared_ptr<Node> next_child(
             const std::shared_ptr<Node>& parent) const
     {
+        if (pricing_context_ != nullptr && pricing_context_->needs_to_end()) {
+            parent->next_child_pos = instance_.number_of_items();
+            return nullptr;
+        }
+
         // Get the next item to add.
         ItemId item_id_next = parent->next_child_pos;
 
@@ -348,6 +362,9 @@ private:
 
     mutable NodeId node_id_ = 0;
 
+    /** Context of the pricing call. */
+    const PricingContext* pricing_context_ = nullptr;
+
 };
 
 }
@@ -0,0 +1,551 @@
+/**
+ * Synthetic set partitioning and set covering models
+ *
+ * Models of configurable size, generated from a seed, used to measure the
+ * performance and the scalability of the library without any external data.
+ *
+ * Program:
+ *
+ * min ∑ₖ cₖ yᵏ
+ *
+ * 1 <= ∑ₖ xᵢᵏ yᵏ <= 1     for all rows i       (set partitioning)
+ * 1 <= ∑ₖ xᵢᵏ yᵏ          for all rows i       (set covering)
+ *                                                         Dual variables: vᵢ
+ *
+ * The columns are drawn from a fixed universe: a few random partitions of
+ * the rows, so that the model is always feasible, completed with random
+ * subsets of the rows. The cost of a column is its number of elements plus
+ * a random perturbation in [0, 1).
+ *
+ * The pricing solver is a mock: it scans the whole universe for the columns
+ * of best reduced costs, so that it is exact and its cost only depends on
+ * the size of the universe. The universe is stored contiguously and a
+ * 'Column' is only built the first time it is returned, so that models
+ * with millions of rows and columns fit in memory.
+ *
+ * For the set partitioning model, the pricing solver also implements the
+ * Ryan-Foster branching rule, so that the model can be solved with
+ * 'branch_and_price': the two children of a pair of rows (i, j) covered
+ * fractionally by the same columns contain the columns covering both or
+ * none of them, and the columns covering at most one of them.
+ *
+ */
+
+#pragma once
+
+#include "columngenerationsolver/commons.hpp"
+
+#include <cmath>
+#include <random>
+#include <numeric>
+#include <stdexcept>
+#include <algorithm>
+#include <unordered_map>
+
+namespace columngenerationsolver
+{
+namespace set_partitioning
+{
+
+struct SetPartitioningParameters
+{
+    /** Number of rows. */
+    RowIdx number_of_rows = 100;
+
+    /** Number of columns of the universe. */
+    ColIdx number_of_columns = 1000;
+
+    /** Number of elements of each column. */
+    RowIdx number_of_elements_per_column = 5;
+
+    /** Number of random partitions of the rows in the universe. */
+    Counter number_of_partitions = 2;
+
+    /** Maximum number of columns returned by each pricing call. */
+    ColIdx maximum_number_of_columns_per_pricing = 10;
+
+    /**
+     * Generate a set covering model instead of a set partitioning model.
+     *
+     * Set covering models are not supported by 'branch_and_price'.
+     */
+    bool set_covering = false;
+
+    /** Seed. */
+    Counter seed = 0;
+};
+
+/**
+ * Universe of columns of a synthetic model.
+ *
+ * The elements of column 'column_id' are the rows
+ * 'rows[column_starts[column_id]]' to 'rows[column_starts[column_id + 1] - 1]',
+ * in increasing order.
+ */
+struct SetPartitioningUniverse
+{
+    /** Position of the first element of each column in 'rows'. */
+    std::vector<ColIdx> column_starts = {0};
+
+    /** Rows of the elements of the columns. */
+    std::vector<RowIdx> rows;
+
+    /** Objective coefficients of the columns. */
+    std::vector<Value> objective_coefficients;
+
+    /** Number of columns of the first partition of the rows. */
+    ColIdx number_of_partition_columns = 0;
+
+    /** Get the number of columns. */
+    ColIdx number_of_columns() const { return objective_coefficients.size(); }
+};
+
+/**
+ * Generate the universe of columns of a synthetic model.
+ */
+inline SetPartitioningUniverse generate_set_partitioning_universe(
+        const SetPartitioningParameters& parameters)
+{
+    if (parameters.number_of_rows <= 0) {
+        throw std::invalid_argument(
+                "columngenerationsolver::set_partitioning::generate_set_partitioning_universe: "
+                "'number_of_rows' must be > 0; "
+                "number_of_rows: " + std::to_string(parameters.number_of_rows) + ".");
+    }
+    if (parameters.number_of_elements_per_column <= 0
+            || parameters.number_of_elements_per_column > parameters.number_of_rows) {
+        throw std::invalid_argument(
+                "columngenerationsolver::set_partitioning::generate_set_partitioning_universe: "
+                "'number_of_elements_per_column' must be in [1, number_of_rows]; "
+                "number_of_elements_per_column: " + std::to_string(parameters.number_of_elements_per_column) + "; "
+                "number_of_rows: " + std::to_string(parameters.number_of_rows) + ".");
+    }
+
+    std::mt19937_64 generator(parameters.seed);
+    std::uniform_real_distribution<Value> distribution(0.0, 1.0);
+    std::vector<RowIdx> rows(parameters.number_of_rows);
+    std::iota(rows.begin(), rows.end(), 0);
+
+    SetPartitioningUniverse universe;
+    ColIdx number_of_partition_columns
+        = (parameters.number_of_rows + parameters.number_of_elements_per_column - 1)
+        / parameters.number_of_elements_per_column;
+    ColIdx number_of_columns = (std::max)(
+            parameters.number_of_columns,
+            parameters.number_of_partitions * number_of_partition_columns);
+    universe.column_starts.reserve(number_of_columns + 1);
+    universe.rows.reserve(number_of_columns * parameters.number_of_elements_per_column);
+    universe.objective_coefficients.reserve(number_of_columns);
+    auto add_column = [&universe, &distribution, &generator](
+            std::vector<RowIdx>::const_iterator first,
+            std::vector<RowIdx>::const_iterator last)
+    {
+        auto column_first = universe.rows.insert(universe.rows.end(), first, last);
+        std::sort(column_first, universe.rows.end());
+        universe.column_starts.push_back(universe.rows.size());
+        universe.objective_coefficients.push_back(
+                (Value)(last - first) + distribution(generator));
+    };
+
+    // Partitions.
+    for (Counter partition_id = 0;
+            partition_id < parameters.number_of_partitions;
+            ++partition_id) {
+        std::shuffle(rows.begin(), rows.end(), generator);
+        for (RowIdx row_pos = 0;
+                row_pos < parameters.number_of_rows;
+                row_pos += parameters.number_of_elements_per_column) {
+            RowIdx row_pos_end = (std::min)(
+                    parameters.number_of_rows,
+                    row_pos + parameters.number_of_elements_per_column);
+            add_column(rows.begin() + row_pos, rows.begin() + row_pos_end);
+        }
+        if (partition_id == 0)
+            universe.number_of_partition_columns = universe.number_of_columns();
+    }
+
+    // Random subsets.
+    while (universe.number_of_columns() < parameters.number_of_columns) {
+        // Partial Fisher-Yates shuffle of the first elements.
+        for (RowIdx row_pos = 0;
+                row_pos < parameters.number_of_elements_per_column;
+                ++row_pos) {
+            std::uniform_int_distribution<RowIdx> distribution_row(
+                    row_pos,
+                    parameters.number_of_rows - 1);
+            std::swap(rows[row_pos], rows[distribution_row(generator)]);
+        }
+        add_column(
+                rows.begin(),
+                rows.begin() + parameters.number_of_elements_per_column);
+    }
+
+    return universe;
+}
+
+/**
+ * Build column 'column_id' of a universe.
+ */
+inline std::shared_ptr<const Column> set_partitioning_column(
+        const SetPartitioningUniverse& universe,
+        ColIdx column_id)
+{
+    auto column = std::make_shared<Column>();
+    column->name = "c" + std::to_string(column_id);
+    column->elements.reserve(
+            universe.column_starts[column_id + 1]
+            - universe.column_starts[column_id]);
+    for (ColIdx pos = universe.column_starts[column_id];
+            pos < universe.column_starts[column_id + 1];
+            ++pos) {
+        column->elements.push_back({universe.rows[pos], 1.0});
+    }
+    column->objective_coefficient = universe.objective_coefficients[column_id];
+    return column;
+}
+
+/**
+ * Generate the universe of columns of a synthetic model, as columns.
+ */
+inline std::vector<std::shared_ptr<const Column>> generate_set_partitioning_columns(
+        const SetPartitioningParameters& parameters)
+{
+    SetPartitioningUniverse universe = generate_set_partitioning_universe(parameters);
+    std::vector<std::shared_ptr<const Column>> columns;
+    columns.reserve(universe.number_of_columns());
+    for (ColIdx column_id = 0;
+            column_id < universe.number_of_columns();
+            ++column_id) {
+        columns.push_back(set_partitioning_column(universe, column_id));
+    }
+    return columns;
+}
+
+/**
+ * Ryan-Foster branching decision of a synthetic set partitioning model.
+ */
+struct SetPartitioningBranchingDecision
+{
+    /** First row. */
+    RowIdx row_id_1;
+
+    /** Second row. */
+    RowIdx row_id_2;
+
+    /**
+     * If 'true', the columns must cover both rows or none of them;
+     * otherwise, they must not cover both rows.
+     */
+    bool together;
+};
+
+/**
+ * Mock pricing solver of a synthetic model.
+ */
+class SetPartitioningPricingSolver: public PricingSolver
+{
+
+public:
+
+    /** Constructor. */
+    SetPartitioningPricingSolver(
+            RowIdx number_of_rows,
+            SetPartitioningUniverse universe,
+            ColIdx maximum_number_of_columns_per_pricing,
+            bool set_covering = false):
+        universe_(std::move(universe)),
+        maximum_number_of_columns_per_pricing_(maximum_number_of_columns_per_pricing),
+        set_covering_(set_covering),
+        columns_(universe_.number_of_columns()),
+        feasible_(universe_.number_of_columns(), 1),
+        fixed_rows_(number_of_rows, 0),
+        branching_rows_(number_of_rows, 0)
+    {
+        if (!set_covering_) {
+            // Each column covers at least one row.
+            maximum_number_of_columns_in_solution_ = number_of_rows;
+        } else if (universe_.number_of_partition_columns > 0) {
+            // The cost of a column is at least 1, and the first partition
+            // is a solution.
+            maximum_number_of_columns_in_solution_ = 0;
+            for (ColIdx column_id = 0;
+                    column_id < universe_.number_of_partition_columns;
+                    ++column_id) {
+                maximum_number_of_columns_in_solution_
+                    += universe_.objective_coefficients[column_id];
+            }
+        }
+    }
+
+    virtual std::vector<std::shared_ptr<const Column>> initialize_pricing(
+            const std::vector<std::pair<std::shared_ptr<const Column>, Value>>& fixed_columns,
+            const std::vector<std::shared_ptr<const Cut>>&,
+            const std::vector<std::shared_ptr<const BranchingDecision>>& branching_decisions) override
+    {
+        for (const SetPartitioningBranchingDecision& decision: decisions_) {
+            branching_rows_[decision.row_id_1] = 0;
+            branching_rows_[decision.row_id_2] = 0;
+        }
+        decisions_.clear();
+        for (const auto& branching_decision: branching_decisions) {
+            const SetPartitioningBranchingDecision& decision
+                = *std::static_pointer_cast<const SetPartitioningBranchingDecision>(
+                        branching_decision->extra);
+            decisions_.push_back(decision);
+            branching_rows_[decision.row_id_1] = 1;
+            branching_rows_[decision.row_id_2] = 1;
+        }
+
+        // In a set covering model, the rows covered by the fixed columns
+        // can still be covered by other columns.
+        std::fill(fixed_rows_.begin(), fixed_rows_.end(), 0);
+        if (!set_covering_) {
+            for (const auto& p: fixed_columns) {
+                if (p.second < 0.5)
+                    continue;
+                for (const LinearTerm& element: p.first->elements)
+                    fixed_rows_[element.row] = 1;
+            }
+        }
+
+        for (ColIdx column_id = 0;
+                column_id < universe_.number_of_columns();
+                ++column_id) {
+            feasible_[column_id] = feasible(column_id);
+        }
+
+        std::vector<std::shared_ptr<const Column>> infeasible_columns;
+        for (ColIdx column_id: built_column_ids_)
+            if (!feasible_[column_id])
+                infeasible_columns.push_back(columns_[column_id]);
+        return infeasible_columns;
+    }
+
+    virtual PricingOutput solve_pricing(
+            bool solve_feasibility,
+            const std::vector<Value>& duals,
+            const std::vector<std::pair<std::shared_ptr<const Cut>, Value>>&,
+            Counter,
+            const PricingContext&) override
+    {
+        // Max-heap of the best columns found so far.
+        std::vector<std::pair<Value, ColIdx>> candidates;
+        Value reduced_cost_best = 0.0;
+        for (ColIdx column_id = 0;
+                column_id < universe_.number_of_columns();
+                ++column_id) {
+            if (!feasible_[column_id])
+                continue;
+            Value reduced_cost = (solve_feasibility)?
+                0: universe_.objective_coefficients[column_id];
+            for (ColIdx pos = universe_.column_starts[column_id];
+                    pos < universe_.column_starts[column_id + 1];
+                    ++pos) {
+                reduced_cost -= duals[universe_.rows[pos]];
+            }
+            reduced_cost_best = (std::min)(reduced_cost_best, reduced_cost);
+            if (reduced_cost >= 0)
+                continue;
+            if ((ColIdx)candidates.size() < maximum_number_of_columns_per_pricing_) {
+                candidates.push_back({reduced_cost, column_id});
+                std::push_heap(candidates.begin(), candidates.end());
+            } else if (!candidates.empty()
+                    && reduced_cost < candidates.front().first) {
+                std::pop_heap(candidates.begin(), candidates.end());
+                candidates.back() = {reduced_cost, column_id};
+                std::push_heap(candidates.begin(), candidates.end());
+            }
+        }
+        std::sort_heap(candidates.begin(), candidates.end());
+
+        PricingOutput output;
+        for (const auto& candidate: candidates)
+            output.columns.push_back(column(candidate.second));
+        output.overcost = (reduced_cost_best < 0)?
+            maximum_number_of_columns_in_solution_ * reduced_cost_best: 0;
+        return output;
+    }
+
+    virtual std::vector<BranchingCandidate> compute_branching_candidates(
+            const Solution& solution) override
+    {
+        if (set_covering_)
+            return {};
+
+        // Value of each pair of rows covered by a fractional column.
+        RowIdx number_of_rows = fixed_rows_.size();
+        std::unordered_map<RowIdx, Value> pair_values;
+        for (int step = 0; step < 2; ++step) {
+            for (const auto& p: solution.columns()) {
+                bool fractional = p.second > FFOT_TOL && p.second < 1 - FFOT_TOL;
+                if (step == 0 && !fractional)
+                    continue;
+                const std::vector<LinearTerm>& elements = p.first->elements;
+                for (auto it_1 = elements.begin(); it_1 != elements.end(); ++it_1) {
+                    for (auto it_2 = std::next(it_1); it_2 != elements.end(); ++it_2) {
+                        RowIdx row_id_1 = (std::min)(it_1->row, it_2->row);
+                        RowIdx row_id_2 = (std::max)(it_1->row, it_2->row);
+                        RowIdx key = row_id_1 * number_of_rows + row_id_2;
+                        if (step == 0) {
+                            pair_values[key] = 0;
+                        } else {
+                            auto it = pair_values.find(key);
+                            if (it != pair_values.end())
+                                it->second += p.second;
+                        }
+                    }
+                }
+            }
+        }
+
+        std::vector<BranchingCandidate> candidates;
+        for (const auto& p: pair_values) {
+            if (p.second < FFOT_TOL || p.second > 1 - FFOT_TOL)
+                continue;
+            BranchingCandidate candidate;
+            candidate.score = -std::abs(p.second - 0.5);
+            for (bool together: {true, false}) {
+                auto branching_decision = std::make_shared<BranchingDecision>();
+                branching_decision->extra = std::make_shared<SetPartitioningBranchingDecision>(
+                        SetPartitioningBranchingDecision{
+                            p.first / number_of_rows,
+                            p.first % number_of_rows,
+                            together});
+                candidate.branching_decisions.push_back(branching_decision);
+            }
+            candidates.push_back(candidate);
+        }
+        // Make the order of the candidates independent of the hash map.
+        std::sort(
+                candidates.begin(),
+                candidates.end(),
+                [](
+                    const BranchingCandidate& candidate_1,
+                    const BranchingCandidate& candidate_2)
+                {
+                    const auto& decision_1 = *std::static_pointer_cast<const SetPartitioningBranchingDecision>(
+                            candidate_1.branching_decisions.front()->extra);
+                    const auto& decision_2 = *std::static_pointer_cast<const SetPartitioningBranchingDecision>(
+                            candidate_2.branching_decisions.front()->extra);
+                    if (decision_1.row_id_1 != decision_2.row_id_1)
+                        return decision_1.row_id_1 < decision_2.row_id_1;
+                    return decision_1.row_id_2 < decision_2.row_id_2;
+                });
+        return candidates;
+    }
+
+private:
+
+    /** Get column 'column_id' of the universe, building it if necessary. */
+    const std::shared_ptr<const Column>& column(ColIdx column_id)
+    {
+        if (columns_[column_id] == nullptr) {
+            columns_[column_id] = set_partitioning_column(universe_, column_id);
+            built_column_ids_.push_back(column_id);
+        }
+        return columns_[column_id];
+    }
+
+    /**
+     * Return 'true' iff column 'column_id' doesn't cover any row of a fixed
+     * column and satisfies the branching decisions.
+     */
+    bool feasible(ColIdx column_id) const
+    {
+        auto first = universe_.rows.begin() + universe_.column_starts[column_id];
+        auto last = universe_.rows.begin() + universe_.column_starts[column_id + 1];
+        for (auto it = first; it != last; ++it)
+            if (fixed_rows_[*it])
+                return false;
+        if (decisions_.empty())
+            return true;
+        for (auto it = first; it != last; ++it) {
+            if (!branching_rows_[*it])
+                continue;
+            for (const SetPartitioningBranchingDecision& decision: decisions_) {
+                RowIdx row_id_other = -1;
+                if (decision.row_id_1 == *it) {
+                    row_id_other = decision.row_id_2;
+                } else if (decision.row_id_2 == *it) {
+                    row_id_other = decision.row_id_1;
+                } else {
+                    continue;
+                }
+                bool covers_other = std::binary_search(first, last, row_id_other);
+                if (decision.together && !covers_other)
+                    return false;
+                if (!decision.together && covers_other)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /** Universe of columns. */
+    SetPartitioningUniverse universe_;
+
+    /** Maximum number of columns returned by each pricing call. */
+    ColIdx maximum_number_of_columns_per_pricing_;
+
+    /** 'true' for a set covering model. */
+    bool set_covering_;
+
+    /**
+     * Upper bound on the number of columns of an optimal solution of the
+     * linear relaxation, used to compute the overcost.
+     */
+    Value maximum_number_of_columns_in_solution_ = std::numeric_limits<Value>::infinity();
+
+    /** Columns of the universe already built, 'nullptr' for the others. */
+    std::vector<std::shared_ptr<const Column>> columns_;
+
+    /** Ids of the columns already built. */
+    std::vector<ColIdx> built_column_ids_;
+
+    /** For each column of the universe, 1 iff it can be generated. */
+    std::vector<uint8_t> feasible_;
+
+    /** For each row, 1 iff it is covered by a fixed column. */
+    std::vector<uint8_t> fixed_rows_;
+
+    /** For each row, 1 iff it is part of a branching decision. */
+    std::vector<uint8_t> branching_rows_;
+
+    /** Branching decisions. */
+    std::vector<SetPartitioningBranchingDecision> decisions_;
+
+};
+
+/**
+ * Build a synthetic model, with its mock pricing solver.
+ */
+inline Model generate_set_partitioning_model(
+        const SetPartitioningParameters& parameters)
+{
+    SetPartitioningUniverse universe
+        = generate_set_partitioning_universe(parameters);
+
+    Model model;
+    model.objective_sense = optimizationtools::ObjectiveDirection::Minimize;
+    model.rows.reserve(parameters.number_of_rows);
+    for (RowIdx row_id = 0; row_id < parameters.number_of_rows; ++row_id) {
+        Row row;
+        row.name = "r" + std::to_string(row_id);
+        row.lower_bound = 1;
+        row.upper_bound = (parameters.set_covering)?
+            std::numeric_limits<Value>::infinity(): 1;
+        row.coefficient_lower_bound = 0;
+        row.coefficient_upper_bound = 1;
+        model.rows.push_back(row);
+    }
+    model.pricing_solver = std::unique_ptr<PricingSolver>(
+            new SetPartitioningPricingSolver(
+                parameters.number_of_rows,
+                std::move(universe),
+                parameters.maximum_number_of_columns_per_pricing,
+                parameters.set_covering));
+    return model;
+}
+
+}
+}
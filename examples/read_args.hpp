@@ -1,10 +1,16 @@
 #include "columngenerationsolver/algorithms/column_generation.hpp"
+#include "columngenerationsolver/algorithms/lagrangian_relaxation.hpp"
 #include "columngenerationsolver/algorithms/greedy.hpp"
 #include "columngenerationsolver/algorithms/limited_discrepancy_search.hpp"
 #include "columngenerationsolver/algorithms/branch_and_price.hpp"
+#include "columngenerationsolver/pricing_solver_recording.hpp"
+#include "columngenerationsolver/event_stream.hpp"
+#include "columngenerationsolver/column_pool_file.hpp"
 
 #include <boost/program_options.hpp>
 
+#include <unordered_set>
+
 #if XPRESS_FOUND
 #include <xprs.h>
 #endif
@@ -12,12 +18,25 @@
 namespace columngenerationsolver
 {
 
-inline boost::program_options::options_description setup_args()
+/**
+ * Setup the options shared by all the examples.
+ *
+ * 'input_required' is 'false' for the examples which don't read their
+ * instance from a file.
+ */
+inline boost::program_options::options_description setup_args(
+        bool input_required = true)
 {
     boost::program_options::options_description desc("Allowed options");
     desc.add_options()
         ("help,h", "produce help message")
-        ("input,i", boost::program_options::value<std::string>()->required(), "set input path (required)")
+        ;
+    if (input_required) {
+        desc.add_options()
+            ("input,i", boost::program_options::value<std::string>()->required(), "set input path (required)")
+            ;
+    }
+    desc.add_options()
         ("output,o", boost::program_options::value<std::string>()->default_value(""), "set JSON output path")
         ("certificate,c", boost::program_options::value<std::string>(), "set certificate path")
         ("format,f", boost::program_options::value<std::string>()->default_value(""), "set input file format (default: orlibrary)")
@@ -25,6 +44,8 @@ inline boost::program_options::options_description setup_args()
         ("time-limit,t", boost::program_options::value<double>(), "set time limit in seconds\n  ex: 3600")
         ("verbosity-level,v", boost::program_options::value<int>(), "set verbosity level")
         ("only-write-at-the-end,e", "only write output and certificate files at the end")
+        ("event-stream", boost::program_options::value<std::string>(), "set the path of the event stream (one JSON object per line); the JSON output is then only written at the end")
+        ("asynchronous-certificate", "write the certificates of the new best solutions from a background thread")
         ("log,l", boost::program_options::value<std::string>(), "set log file")
         ("log-to-stderr", "write log to stderr")
         ("print-checker", boost::program_options::value<int>()->default_value(1), "print checker")
@@ -32,17 +53,52 @@ inline boost::program_options::options_description setup_args()
         ("linear-programming-solver", boost::program_options::value<SolverName>(), "set linear programming solver")
         ("internal-diving", boost::program_options::value<int>(), "set internal diving")
         ("rounding-heuristic", boost::program_options::value<int>(), "set rounding heuristic")
+        ("memory-usage-log-interval", boost::program_options::value<double>(), "set the interval in seconds between two prints of the memory usage (-1: never)")
         ("discrepancy-limit", boost::program_options::value<int>(), "set discrepancy limit")
+        ("penalty-stabilization", boost::program_options::value<bool>(), "set penalty stabilization")
+        ("penalty-stabilization-box-half-width", boost::program_options::value<double>(), "set the half-width of the box of the penalty stabilization")
+        ("penalty-stabilization-initial-penalty", boost::program_options::value<double>(), "set the initial penalty of the penalty stabilization")
+        ("dual-optimal-inequalities", boost::program_options::value<bool>(), "use the dual-optimal inequalities of the model")
+        ("interior-point", boost::program_options::value<bool>(), "solve the master with an interior point method until close to convergence")
+        ("maximum-number-of-columns-per-iteration", boost::program_options::value<Counter>(), "set the maximum number of columns added to the LP at each iteration")
+        ("adaptive-number-of-columns-per-iteration", boost::program_options::value<bool>(), "adapt the number of columns added to the LP at each iteration")
+        ("column-selection-diversity", boost::program_options::value<double>(), "set the weight of the diversity of the columns added to the LP")
+        ("pricing-time-budget", boost::program_options::value<double>(), "set the initial time budget of the pricing calls")
+        ("pricing-time-budget-growth-factor", boost::program_options::value<double>(), "set the growth factor of the time budget of the pricing calls")
+        ("concurrent-pricing-levels", boost::program_options::value<bool>(), "call the pricing solver for all the pricing levels concurrently")
+        ("iteration-trace", boost::program_options::value<std::string>(), "set the path of the column generation iteration trace")
+        ("iteration-trace-format", boost::program_options::value<IterationTraceFormat>(), "set the format of the column generation iteration trace (ndjson, csv)")
+        ("record-pricing", boost::program_options::value<std::string>(), "record the calls to the pricing solver to a file")
+        ("replay-pricing", boost::program_options::value<std::string>(), "replay the calls to the pricing solver recorded in a file instead of running it")
+        ("replay-pricing-strict", "fail when a replayed call to the pricing solver has no recorded call with the same input")
+        ("column-pool-input", boost::program_options::value<std::string>(), "set the path of a column pool file whose columns are added to the column pool")
+        ("column-pool-output", boost::program_options::value<std::string>(), "set the path of the column pool file the columns of the column pool and the columns generated are written to")
+        ("tailing-off-window-size", boost::program_options::value<Counter>(), "set the window size of the tailing-off criterion")
+        ("tailing-off-minimum-relative-improvement", boost::program_options::value<double>(), "set the minimum relative improvement of the tailing-off criterion")
+        ("tailing-off-maximum-relative-gap", boost::program_options::value<double>(), "set the maximum relative gap of the tailing-off criterion")
+        ("non-root-tailing-off-window-size", boost::program_options::value<Counter>(), "set the window size of the tailing-off criterion at non-root nodes")
+        ("non-root-tailing-off-minimum-relative-improvement", boost::program_options::value<double>(), "set the minimum relative improvement of the tailing-off criterion at non-root nodes")
+        ("non-root-tailing-off-maximum-relative-gap", boost::program_options::value<double>(), "set the maximum relative gap of the tailing-off criterion at non-root nodes")
         ("automatic-stop", boost::program_options::value<bool>(), "set automatic stop")
         ("maximum-number-of-branching-candidates", boost::program_options::value<Counter>(), "set the maximum number of branching candidates strong-branch evaluated per node (branch-and-price)")
         ("strong-branching-maximum-number-of-iterations", boost::program_options::value<Counter>(), "set the maximum number of column generation iterations used while strong-branch evaluating a candidate (branch-and-price)")
+        ("lagrangian-strong-branching", boost::program_options::value<bool>(), "strong-branch evaluate candidates with the Lagrangian relaxation (branch-and-price)")
+        ("maximum-number-of-iterations", boost::program_options::value<Counter>(), "set the maximum number of iterations (lagrangian-relaxation)")
+        ("open-nodes-memory-limit", boost::program_options::value<Counter>(), "set the memory budget of the open nodes in bytes (branch-and-price)")
+        ("open-nodes-spill-path", boost::program_options::value<std::string>(), "set the path of the file open nodes are spilled to (branch-and-price)")
         ;
     return desc;
 }
 
 using WriteSolutionFunction = std::function<void(const Solution&, const std::string&)>;
 
-inline void read_args(
+/**
+ * Set the common parameters from the command line arguments.
+ *
+ * Return the writer of the certificates if they are written from a
+ * background thread, 'nullptr' otherwise; 'write_output' waits for it.
+ */
+inline std::shared_ptr<BackgroundWriter> read_args(
         Parameters& parameters,
         const WriteSolutionFunction& write_solution,
         const boost::program_options::variables_map& vm,
@@ -58,20 +114,45 @@ inline void read_args(
     if (vm.count("log"))
         parameters.log_path = vm["log"].as<std::string>();
     parameters.log_to_stderr = vm.count("log-to-stderr");
+    if (vm.count("event-stream")) {
+        parameters.event_stream_writer = std::make_shared<EventStreamWriter>(
+                vm["event-stream"].as<std::string>());
+    }
     bool only_write_at_the_end = vm.count("only-write-at-the-end");
+    std::shared_ptr<BackgroundWriter> certificate_writer = nullptr;
     if (!only_write_at_the_end) {
+        // With an event stream, the new best solutions are already in the
+        // events, so the whole JSON output isn't rewritten for each of them.
+        bool write_json_output = !vm.count("event-stream");
+        if (vm.count("asynchronous-certificate"))
+            certificate_writer = std::make_shared<BackgroundWriter>();
         parameters.new_solution_callback = [
             vm,
-            write_solution](
+            write_solution,
+            write_json_output,
+            certificate_writer](
                     const Output& output)
         {
-            if (vm.count("output"))
+            if (write_json_output && vm.count("output"))
                 output.write_json_output(vm["output"].as<std::string>());
             if (vm.count("certificate")
                     && output.solution.feasible()) {
-                write_solution(
-                        output.solution,
-                        vm["certificate"].as<std::string>());
+                if (certificate_writer == nullptr) {
+                    write_solution(
+                            output.solution,
+                            vm["certificate"].as<std::string>());
+                } else {
+                    // 'output' keeps changing, so the solution is copied.
+                    std::string certificate_path = vm["certificate"].as<std::string>();
+                    Solution solution = output.solution;
+                    certificate_writer->submit([
+                            write_solution,
+                            solution,
+                            certificate_path]()
+                    {
+                        write_solution(solution, certificate_path);
+                    });
+                }
             }
         };
     }
@@ -81,13 +162,107 @@ inline void read_args(
         parameters.internal_diving = vm["internal-diving"].as<int>();
     if (vm.count("rounding-heuristic"))
         parameters.rounding_heuristic = vm["rounding-heuristic"].as<int>();
+    if (vm.count("memory-usage-log-interval"))
+        parameters.memory_usage_log_interval = vm["memory-usage-log-interval"].as<double>();
+    return certificate_writer;
+}
+
+inline void read_tailing_off_args(
+        TailingOffParameters& tailing_off,
+        const boost::program_options::variables_map& vm,
+        const std::string& prefix)
+{
+    if (vm.count(prefix + "tailing-off-window-size"))
+        tailing_off.window_size = vm[prefix + "tailing-off-window-size"].as<Counter>();
+    if (vm.count(prefix + "tailing-off-minimum-relative-improvement"))
+        tailing_off.minimum_relative_improvement = vm[prefix + "tailing-off-minimum-relative-improvement"].as<double>();
+    if (vm.count(prefix + "tailing-off-maximum-relative-gap"))
+        tailing_off.maximum_relative_gap = vm[prefix + "tailing-off-maximum-relative-gap"].as<double>();
+}
+
+inline void read_column_generation_args(
+        ColumnGenerationParameters& parameters,
+        const boost::program_options::variables_map& vm)
+{
+    if (vm.count("linear-programming-solver"))
+        parameters.solver_name = vm["linear-programming-solver"].as<SolverName>();
+    if (vm.count("penalty-stabilization"))
+        parameters.penalty_stabilization = vm["penalty-stabilization"].as<bool>();
+    if (vm.count("penalty-stabilization-box-half-width"))
+        parameters.penalty_stabilization_box_half_width = vm["penalty-stabilization-box-half-width"].as<double>();
+    if (vm.count("penalty-stabilization-initial-penalty"))
+        parameters.penalty_stabilization_initial_penalty = vm["penalty-stabilization-initial-penalty"].as<double>();
+    if (vm.count("dual-optimal-inequalities"))
+        parameters.dual_optimal_inequalities = vm["dual-optimal-inequalities"].as<bool>();
+    if (vm.count("interior-point"))
+        parameters.interior_point = vm["interior-point"].as<bool>();
+    if (vm.count("maximum-number-of-columns-per-iteration"))
+        parameters.maximum_number_of_columns_per_iteration = vm["maximum-number-of-columns-per-iteration"].as<Counter>();
+    if (vm.count("adaptive-number-of-columns-per-iteration"))
+        parameters.adaptive_number_of_columns_per_iteration = vm["adaptive-number-of-columns-per-iteration"].as<bool>();
+    if (vm.count("column-selection-diversity"))
+        parameters.column_selection_diversity = vm["column-selection-diversity"].as<double>();
+    if (vm.count("pricing-time-budget"))
+        parameters.pricing_time_budget = vm["pricing-time-budget"].as<double>();
+    if (vm.count("pricing-time-budget-growth-factor"))
+        parameters.pricing_time_budget_growth_factor = vm["pricing-time-budget-growth-factor"].as<double>();
+    if (vm.count("concurrent-pricing-levels"))
+        parameters.concurrent_pricing_levels = vm["concurrent-pricing-levels"].as<bool>();
+    if (vm.count("iteration-trace")) {
+        IterationTraceFormat format = IterationTraceFormat::Ndjson;
+        if (vm.count("iteration-trace-format"))
+            format = vm["iteration-trace-format"].as<IterationTraceFormat>();
+        parameters.iteration_trace_writer = std::make_shared<IterationTraceWriter>(
+                vm["iteration-trace"].as<std::string>(),
+                format);
+    }
+    read_tailing_off_args(parameters.tailing_off, vm, "");
+}
+
+inline void read_pricing_solver_args(
+        Model& model,
+        const boost::program_options::variables_map& vm)
+{
+    if (vm.count("record-pricing") && vm.count("replay-pricing")) {
+        throw std::invalid_argument(
+                "Options \"record-pricing\" and \"replay-pricing\" can't be used together.");
+    }
+    if (vm.count("record-pricing")) {
+        model.pricing_solver = std::unique_ptr<PricingSolver>(
+                new RecordingPricingSolver(
+                    std::move(model.pricing_solver),
+                    vm["record-pricing"].as<std::string>()));
+    }
+    if (vm.count("replay-pricing")) {
+        // The replayed columns don't have their 'extra' field, which is
+        // needed to write a certificate.
+        if (vm.count("certificate")) {
+            throw std::invalid_argument(
+                    "Options \"replay-pricing\" and \"certificate\" can't be used together.");
+        }
+        model.pricing_solver = std::unique_ptr<PricingSolver>(
+                new ReplayPricingSolver(
+                    vm["replay-pricing"].as<std::string>(),
+                    vm.count("replay-pricing-strict")));
+    }
 }
 
 inline void write_output(
         const WriteSolutionFunction& write_solution,
         const boost::program_options::variables_map& vm,
+        const Parameters& parameters,
+        const std::shared_ptr<BackgroundWriter>& certificate_writer,
         const Output& output)
 {
+    // Wait for the certificate being written in the background, if any,
+    // before the final one is written, and report its errors.
+    if (certificate_writer != nullptr) {
+        certificate_writer->wait();
+        if (parameters.verbosity_level > 0) {
+            std::cout << "Number of skipped certificate writes: "
+                << certificate_writer->number_of_skipped_writes() << std::endl;
+        }
+    }
     if (vm.count("output"))
         output.write_json_output(vm["output"].as<std::string>());
     if (vm.count("certificate")
@@ -106,9 +281,13 @@ inline const Output run_column_generation(
         const std::vector<std::shared_ptr<const Column>>& initial_columns)
 {
     ColumnGenerationParameters parameters;
-    read_args(parameters, write_solution, vm, column_pool, initial_columns);
-    if (vm.count("linear-programming-solver"))
-        parameters.solver_name = vm["linear-programming-solver"].as<SolverName>();
+    std::shared_ptr<BackgroundWriter> certificate_writer = read_args(
+            parameters,
+            write_solution,
+            vm,
+            column_pool,
+            initial_columns);
+    read_column_generation_args(parameters, vm);
 #if XPRESS_FOUND
     if (parameters.solver_name
             == SolverName::Xpress)
@@ -120,7 +299,28 @@ inline const Output run_column_generation(
             == SolverName::Xpress)
         XPRSfree();
 #endif
-    write_output(write_solution, vm, output);
+    write_output(write_solution, vm, parameters, certificate_writer, output);
+    return output;
+}
+
+inline const Output run_lagrangian_relaxation(
+        const Model& model,
+        const WriteSolutionFunction& write_solution,
+        const boost::program_options::variables_map& vm,
+        const std::vector<std::shared_ptr<const Column>>& column_pool,
+        const std::vector<std::shared_ptr<const Column>>& initial_columns)
+{
+    LagrangianRelaxationParameters parameters;
+    std::shared_ptr<BackgroundWriter> certificate_writer = read_args(
+            parameters,
+            write_solution,
+            vm,
+            column_pool,
+            initial_columns);
+    if (vm.count("maximum-number-of-iterations"))
+        parameters.maximum_number_of_iterations = vm["maximum-number-of-iterations"].as<Counter>();
+    const Output output = lagrangian_relaxation(model, parameters);
+    write_output(write_solution, vm, parameters, certificate_writer, output);
     return output;
 }
 
@@ -132,11 +332,14 @@ inline const Output run_greedy(
         const std::vector<std::shared_ptr<const Column>>& initial_columns)
 {
     GreedyParameters parameters;
-    read_args(parameters, write_solution, vm, column_pool, initial_columns);
-    if (vm.count("linear-programming-solver")) {
-        parameters.column_generation_parameters.solver_name
-            = vm["linear-programming-solver"].as<SolverName>();
-    }
+    std::shared_ptr<BackgroundWriter> certificate_writer = read_args(
+            parameters,
+            write_solution,
+            vm,
+            column_pool,
+            initial_columns);
+    read_column_generation_args(parameters.column_generation_parameters, vm);
+    read_tailing_off_args(parameters.non_root_tailing_off, vm, "non-root-");
 #if XPRESS_FOUND
     if (parameters.column_generation_parameters.solver_name
             == SolverName::Xpress)
@@ -148,7 +351,7 @@ inline const Output run_greedy(
             == SolverName::Xpress)
         XPRSfree();
 #endif
-    write_output(write_solution, vm, output);
+    write_output(write_solution, vm, parameters, certificate_writer, output);
     return output;
 }
 
@@ -160,11 +363,14 @@ inline const Output run_limited_discrepancy_search(
         const std::vector<std::shared_ptr<const Column>>& initial_columns)
 {
     LimitedDiscrepancySearchParameters parameters;
-    read_args(parameters, write_solution, vm, column_pool, initial_columns);
-    if (vm.count("linear-programming-solver")) {
-        parameters.column_generation_parameters.solver_name
-            = vm["linear-programming-solver"].as<SolverName>();
-    }
+    std::shared_ptr<BackgroundWriter> certificate_writer = read_args(
+            parameters,
+            write_solution,
+            vm,
+            column_pool,
+            initial_columns);
+    read_column_generation_args(parameters.column_generation_parameters, vm);
+    read_tailing_off_args(parameters.non_root_tailing_off, vm, "non-root-");
 #if XPRESS_FOUND
     if (parameters.column_generation_parameters.solver_name
             == SolverName::Xpress)
@@ -180,7 +386,7 @@ inline const Output run_limited_discrepancy_search(
             == SolverName::Xpress)
         XPRSfree();
 #endif
-    write_output(write_solution, vm, output);
+    write_output(write_solution, vm, parameters, certificate_writer, output);
     return output;
 }
 
@@ -192,11 +398,14 @@ inline const Output run_branch_and_price(
         const std::vector<std::shared_ptr<const Column>>& initial_columns)
 {
     BranchAndPriceParameters parameters;
-    read_args(parameters, write_solution, vm, column_pool, initial_columns);
-    if (vm.count("linear-programming-solver")) {
-        parameters.column_generation_parameters.solver_name
-            = vm["linear-programming-solver"].as<SolverName>();
-    }
+    std::shared_ptr<BackgroundWriter> certificate_writer = read_args(
+            parameters,
+            write_solution,
+            vm,
+            column_pool,
+            initial_columns);
+    read_column_generation_args(parameters.column_generation_parameters, vm);
+    read_tailing_off_args(parameters.non_root_tailing_off, vm, "non-root-");
 #if XPRESS_FOUND
     if (parameters.column_generation_parameters.solver_name
             == SolverName::Xpress)
@@ -206,13 +415,19 @@ inline const Output run_branch_and_price(
         parameters.maximum_number_of_branching_candidates = vm["maximum-number-of-branching-candidates"].as<Counter>();
     if (vm.count("strong-branching-maximum-number-of-iterations"))
         parameters.strong_branching_maximum_number_of_iterations = vm["strong-branching-maximum-number-of-iterations"].as<Counter>();
+    if (vm.count("lagrangian-strong-branching"))
+        parameters.lagrangian_strong_branching = vm["lagrangian-strong-branching"].as<bool>();
+    if (vm.count("open-nodes-memory-limit"))
+        parameters.open_nodes_memory_limit = vm["open-nodes-memory-limit"].as<Counter>();
+    if (vm.count("open-nodes-spill-path"))
+        parameters.open_nodes_spill_path = vm["open-nodes-spill-path"].as<std::string>();
     const Output output = branch_and_price(model, parameters);
 #if XPRESS_FOUND
     if (parameters.column_generation_parameters.solver_name
             == SolverName::Xpress)
         XPRSfree();
 #endif
-    write_output(write_solution, vm, output);
+    write_output(write_solution, vm, parameters, certificate_writer, output);
     return output;
 }
 
@@ -221,22 +436,57 @@ inline Output run(
         const WriteSolutionFunction& write_solution,
         const boost::program_options::variables_map& vm,
         const std::vector<std::shared_ptr<const Column>>& column_pool = {},
-        const std::vector<std::shared_ptr<const Column>>& initial_columns = {})
+        const std::vector<std::shared_ptr<const Column>>& initial_columns = {},
+        const ColumnExtraSerializer& serialize_extra = nullptr,
+        const ColumnExtraDeserializer& deserialize_extra = nullptr)
 {
+    // Add the columns of the column pool file to the column pool.
+    std::vector<std::shared_ptr<const Column>> column_pool_full = column_pool;
+    if (vm.count("column-pool-input")) {
+        std::vector<std::shared_ptr<const Column>> columns = read_column_pool(
+                vm["column-pool-input"].as<std::string>(),
+                model,
+                deserialize_extra);
+        column_pool_full.insert(
+                column_pool_full.end(),
+                columns.begin(),
+                columns.end());
+    }
+
+    Output output(model);
     std::string algorithm = vm["algorithm"].as<std::string>();
     if (algorithm == "column-generation") {
-        return run_column_generation(model, write_solution, vm, column_pool, initial_columns);
+        output = run_column_generation(model, write_solution, vm, column_pool_full, initial_columns);
+    } else if (algorithm == "lagrangian-relaxation") {
+        output = run_lagrangian_relaxation(model, write_solution, vm, column_pool_full, initial_columns);
     } else if (algorithm == "greedy") {
-        return run_greedy(model, write_solution, vm, column_pool, initial_columns);
+        output = run_greedy(model, write_solution, vm, column_pool_full, initial_columns);
     } else if (algorithm == "limited-discrepancy-search") {
-        return run_limited_discrepancy_search(model, write_solution, vm, column_pool, initial_columns);
+        output = run_limited_discrepancy_search(model, write_solution, vm, column_pool_full, initial_columns);
     } else if (algorithm == "branch-and-price") {
-        return run_branch_and_price(model, write_solution, vm, column_pool, initial_columns);
+        output = run_branch_and_price(model, write_solution, vm, column_pool_full, initial_columns);
     } else {
         throw std::invalid_argument(
                 "Unknown algorithm \"" + algorithm + "\".");
     }
-    return Output(model);
+
+    // Write the columns of the column pool and the columns generated, each
+    // column once, so that the next runs start from all of them.
+    if (vm.count("column-pool-output")) {
+        std::vector<std::shared_ptr<const Column>> columns;
+        std::unordered_set<const Column*> written_columns;
+        for (const auto& columns_source: {&column_pool_full, &output.columns})
+            for (const auto& column: *columns_source)
+                if (written_columns.insert(column.get()).second)
+                    columns.push_back(column);
+        write_column_pool(
+                vm["column-pool-output"].as<std::string>(),
+                model.rows.size(),
+                columns,
+                serialize_extra);
+    }
+
+    return output;
 }
 
 }
@@ -0,0 +1,87 @@
+/**
+ * Synthetic set partitioning and set covering models
+ *
+ * Model description:
+ * See 'pricingsolver/set_partitioning.hpp'
+ *
+ * The model is generated from the options instead of being read from a
+ * file, so that the scalability of the algorithms can be studied on models
+ * from a thousand to a million rows without any external data.
+ *
+ * The certificate contains, for each column of the solution, its number of
+ * elements followed by its rows.
+ *
+ */
+
+#include "read_args.hpp"
+
+#include "pricingsolver/set_partitioning.hpp"
+
+using namespace columngenerationsolver;
+using namespace columngenerationsolver::set_partitioning;
+
+inline void write_solution(
+        const Solution& solution,
+        const std::string& certificate_path)
+{
+    std::ofstream file(certificate_path);
+    if (!file.good()) {
+        throw std::runtime_error(
+                "Unable to open file \"" + certificate_path + "\".");
+    }
+
+    for (const auto& colval: solution.columns()) {
+        const Column& column = *(colval.first);
+        Value value = colval.second;
+        for (Counter copy = 0; copy < (Counter)std::round(value); ++copy) {
+            file << column.elements.size();
+            for (const LinearTerm& element: column.elements)
+                file << " " << element.row;
+            file << std::endl;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Setup options.
+    boost::program_options::options_description desc = setup_args(false);
+    desc.add_options()
+        ("number-of-rows", boost::program_options::value<RowIdx>()->default_value(1000), "set the number of rows")
+        ("number-of-columns", boost::program_options::value<ColIdx>()->default_value(10000), "set the number of columns of the universe")
+        ("number-of-elements-per-column", boost::program_options::value<RowIdx>()->default_value(5), "set the number of elements of each column")
+        ("number-of-partitions", boost::program_options::value<Counter>()->default_value(2), "set the number of random partitions of the rows in the universe")
+        ("maximum-number-of-columns-per-pricing", boost::program_options::value<ColIdx>()->default_value(10), "set the maximum number of columns returned by each pricing call")
+        ("set-covering", boost::program_options::value<bool>()->default_value(false), "generate a set covering model instead of a set partitioning model")
+        ("seed,s", boost::program_options::value<Counter>()->default_value(0), "set seed")
+        ;
+    boost::program_options::variables_map vm;
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc), vm);
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;;
+        throw "";
+    }
+    try {
+        boost::program_options::notify(vm);
+    } catch (const boost::program_options::required_option& e) {
+        std::cout << desc << std::endl;;
+        throw "";
+    }
+
+    // Create model.
+    SetPartitioningParameters sp_parameters;
+    sp_parameters.number_of_rows = vm["number-of-rows"].as<RowIdx>();
+    sp_parameters.number_of_columns = vm["number-of-columns"].as<ColIdx>();
+    sp_parameters.number_of_elements_per_column = vm["number-of-elements-per-column"].as<RowIdx>();
+    sp_parameters.number_of_partitions = vm["number-of-partitions"].as<Counter>();
+    sp_parameters.maximum_number_of_columns_per_pricing = vm["maximum-number-of-columns-per-pricing"].as<ColIdx>();
+    sp_parameters.set_covering = vm["set-covering"].as<bool>();
+    sp_parameters.seed = vm["seed"].as<Counter>();
+    Model model = generate_set_partitioning_model(sp_parameters);
+    read_pricing_solver_args(model, vm);
+
+    // Solve.
+    run(model, write_solution, vm);
+
+    return 0;
+}
@@ -46,6 +46,8 @@
 
 #include "optimizationtools/utils/utils.hpp"
 
+#include <cstring>
+
 using namespace orproblems::vehicle_routing_with_time_windows;
 
 using Value = columngenerationsolver::Value;
@@ -60,7 +62,8 @@ public:
     PricingSolver(
             const Instance& instance):
         instance_(instance),
-        visited_customers_(instance.number_of_locations(), 0)
+        visited_customers_(instance.number_of_locations(), 0),
+        cvrp2espp_(instance.number_of_locations(), -1)
     { }
 
     inline virtual std::vector<std::shared_ptr<const columngenerationsolver::Column>> initialize_pricing(
@@ -72,18 +75,36 @@ public:
             bool solve_feasibility,
             const std::vector<Value>& duals,
             const std::vector<std::pair<std::shared_ptr<const columngenerationsolver::Cut>, Value>>& cut_duals,
-            columngenerationsolver::Counter pricing_level);
+            columngenerationsolver::Counter pricing_level,
+            const columngenerationsolver::PricingContext& context);
 
     void set_beam_search_size_of_the_queue(treesearchsolver::NodeId bs_size_of_the_queue) { bs_size_of_the_queue_ = bs_size_of_the_queue; }
 
 private:
 
+    /** Build the subproblem instance from scratch. */
+    void build_subproblem_instance(
+            bool solve_feasibility,
+            const std::vector<Value>& duals);
+
     const Instance& instance_;
 
     std::vector<Demand> visited_customers_;
 
     std::vector<LocationId> espp2cvrp_;
 
+    /** Location of the subproblem instance of each location (-1: none). */
+    std::vector<LocationId> cvrp2espp_;
+
+    /** Subproblem instance, kept while the subproblem generation is the same. */
+    std::unique_ptr<columngenerationsolver::espprctw::Instance> espp_instance_;
+
+    /** Subproblem generation of 'espp_instance_'. */
+    columngenerationsolver::Counter espp_instance_subproblem_generation_ = -1;
+
+    /** Multiplier to convert the times and the duals to integers. */
+    const double multiplier_ = 1000;
+
     treesearchsolver::NodeId bs_size_of_the_queue_ = 64;
 
 };
@@ -146,36 +167,24 @@ struct ColumnExtra
     std::vector<LocationId> route;
 };
 
-// Under 'solve_feasibility', the ESPPRCTW subproblem's arc 'cost' (its
-// objective/guide/bound contribution) is zeroed, while 'travel_time' (the
-// resource that propagates time-window feasibility) is always fed the
-// real value -- these are tracked separately in espprctw::Instance
-// precisely so zeroing one doesn't corrupt the other. The returned
-// columns' real 'objective_coefficient' is still computed from the real
-// 'instance_.travel_time' below, unaffected by this.
-PricingSolver::PricingOutput PricingSolver::solve_pricing(
-            bool solve_feasibility,
-            const std::vector<Value>& duals,
-            const std::vector<std::pair<std::shared_ptr<const columngenerationsolver::Cut>, Value>>&,
-            columngenerationsolver::Counter)
+void PricingSolver::build_subproblem_instance(
+        bool solve_feasibility,
+        const std::vector<Value>& duals)
 {
-    PricingOutput output;
-
-    // Build subproblem instance.
     espp2cvrp_.clear();
     espp2cvrp_.push_back(0);
+    std::fill(cvrp2espp_.begin(), cvrp2espp_.end(), -1);
+    cvrp2espp_[0] = 0;
     for (LocationId location_id = 1;
             location_id < instance_.number_of_locations();
             ++location_id) {
         if (visited_customers_[location_id] == 1)
             continue;
+        cvrp2espp_[location_id] = espp2cvrp_.size();
         espp2cvrp_.push_back(location_id);
     }
     LocationId espp_number_of_locations = espp2cvrp_.size();
-    if (espp_number_of_locations == 1)
-        return output;
     columngenerationsolver::espprctw::InstanceBuilder espp_instance_builder(espp_number_of_locations);
-    double multiplier = 1000;
     for (LocationId espp_location_id = 0;
             espp_location_id < espp_number_of_locations;
             ++espp_location_id) {
@@ -186,16 +195,16 @@ PricingSolver::PricingOutput PricingSolver::solve_pricing(
                 location.demand);
         espp_instance_builder.set_location_profit(
                 espp_location_id,
-                ((location_id != 0)? std::round(multiplier * duals[location_id]): 0));
+                ((location_id != 0)? std::round(multiplier_ * duals[location_id]): 0));
         espp_instance_builder.set_location_release_date(
                 espp_location_id,
-                std::round(multiplier * location.release_date));
+                std::round(multiplier_ * location.release_date));
         espp_instance_builder.set_location_deadline(
                 espp_location_id,
-                std::round(multiplier * location.deadline));
+                std::round(multiplier_ * location.deadline));
         espp_instance_builder.set_location_service_time(
                 espp_location_id,
-                std::round(multiplier * location.service_time));
+                std::round(multiplier_ * location.service_time));
         for (LocationId espp_location_id_2 = 0;
                 espp_location_id_2 < espp_number_of_locations;
                 ++espp_location_id_2) {
@@ -205,15 +214,56 @@ PricingSolver::PricingOutput PricingSolver::solve_pricing(
             espp_instance_builder.set_travel_time(
                     espp_location_id,
                     espp_location_id_2,
-                    std::round(multiplier * instance_.travel_time(location_id, location_id_2)));
+                    std::round(multiplier_ * instance_.travel_time(location_id, location_id_2)));
             espp_instance_builder.set_cost(
                     espp_location_id,
                     espp_location_id_2,
-                    (solve_feasibility)? 0: std::round(multiplier * instance_.travel_time(location_id, location_id_2)));
+                    (solve_feasibility)? 0: std::round(multiplier_ * instance_.travel_time(location_id, location_id_2)));
         }
     }
-    columngenerationsolver::espprctw::Instance espp_instance = espp_instance_builder.build();
-    //espp_instance.format(std::cout, 2);
+    espp_instance_ = std::unique_ptr<columngenerationsolver::espprctw::Instance>(
+            new columngenerationsolver::espprctw::Instance(espp_instance_builder.build()));
+    //espp_instance_->format(std::cout, 2);
+}
+
+// Under 'solve_feasibility', the ESPPRCTW subproblem's arc 'cost' (its
+// objective/guide/bound contribution) is zeroed, while 'travel_time' (the
+// resource that propagates time-window feasibility) is always fed the
+// real value -- these are tracked separately in espprctw::Instance
+// precisely so zeroing one doesn't corrupt the other. The returned
+// columns' real 'objective_coefficient' is still computed from the real
+// 'instance_.travel_time' below, unaffected by this.
+PricingSolver::PricingOutput PricingSolver::solve_pricing(
+            bool solve_feasibility,
+            const std::vector<Value>& duals,
+            const std::vector<std::pair<std::shared_ptr<const columngenerationsolver::Cut>, Value>>&,
+            columngenerationsolver::Counter,
+            const columngenerationsolver::PricingContext& context)
+{
+    PricingOutput output;
+
+    if (espp_instance_ != nullptr
+            && context.has_changed_rows
+            && context.subproblem_generation == espp_instance_subproblem_generation_) {
+        // Same subproblem as the previous call: only update the profits of
+        // the locations whose dual changed.
+        for (columngenerationsolver::RowIdx row_id: context.changed_rows) {
+            if (row_id == 0)
+                continue;
+            LocationId espp_location_id = cvrp2espp_[row_id];
+            if (espp_location_id == -1)
+                continue;
+            espp_instance_->set_location_profit(
+                    espp_location_id,
+                    std::round(multiplier_ * duals[row_id]));
+        }
+    } else {
+        build_subproblem_instance(solve_feasibility, duals);
+        espp_instance_subproblem_generation_ = context.subproblem_generation;
+    }
+    if (espp2cvrp_.size() == 1)
+        return output;
+    const columngenerationsolver::espprctw::Instance& espp_instance = *espp_instance_;
 
     columngenerationsolver::espprctw::BranchingScheme branching_scheme(espp_instance);
 
@@ -223,8 +273,10 @@ PricingSolver::PricingOutput PricingSolver::solve_pricing(
     espp_parameters.minimum_size_of_the_queue = bs_size_of_the_queue_;
     espp_parameters.maximum_size_of_the_queue = bs_size_of_the_queue_;
     espp_parameters.verbosity_level = 0;
+    branching_scheme.set_pricing_context(&context);
     auto espp_output = treesearchsolver::iterative_beam_search(
             branching_scheme, espp_parameters);
+    output.interrupted = context.needs_to_end();
 
     // Retrieve column.
     for (const std::shared_ptr<columngenerationsolver::espprctw::BranchingScheme::Node>& node:
@@ -286,6 +338,28 @@ inline void write_solution(
     }
 }
 
+std::string serialize_column_extra(
+        const columngenerationsolver::Column& column)
+{
+    if (column.extra == nullptr)
+        return "";
+    std::shared_ptr<ColumnExtra> extra
+        = std::static_pointer_cast<ColumnExtra>(column.extra);
+    return std::string(
+            (const char*)extra->route.data(),
+            extra->route.size() * sizeof(LocationId));
+}
+
+std::shared_ptr<void> deserialize_column_extra(
+        const char* data,
+        size_t size)
+{
+    ColumnExtra extra;
+    extra.route.resize(size / sizeof(LocationId));
+    std::memcpy(extra.route.data(), data, size);
+    return std::shared_ptr<void>(new ColumnExtra(extra));
+}
+
 int main(int argc, char *argv[])
 {
     // Setup options.
@@ -315,9 +389,17 @@ int main(int argc, char *argv[])
 
     // Create model.
     columngenerationsolver::Model model = get_model(instance);
+    columngenerationsolver::read_pricing_solver_args(model, vm);
 
     // Solve.
-    auto output = run(model, write_solution, vm);
+    auto output = run(
+            model,
+            write_solution,
+            vm,
+            {},
+            {},
+            serialize_column_extra,
+            deserialize_column_extra);
 
     // Run checker.
     if (vm.count("certificate")
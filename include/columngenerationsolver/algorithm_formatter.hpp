@@ -53,6 +53,16 @@ public:
             double value,
             double bound);
 
+    /** Print the header of the 'lagrangian_relaxation' algorithm. */
+    void print_lagrangian_relaxation_header();
+
+    /** Print current iteration of the 'lagrangian_relaxation' algorithm. */
+    void print_lagrangian_relaxation_iteration(
+            Counter iteration,
+            Value lagrangian_value,
+            Value primal_value,
+            Value step_size_parameter);
+
     /** Print the header of the 'greedy' algorithm. */
     void print_greedy_header();
 
@@ -88,6 +98,13 @@ public:
     void update_bound(
             double bound);
 
+    /**
+     * Update the peaks of the memory usage once 'Output::memory_usage' has
+     * been updated, and print it if the last print is older than
+     * 'Parameters::memory_usage_log_interval'.
+     */
+    void update_memory_usage();
+
     /** Method to call at the end of the algorithm. */
     void end();
 
@@ -100,6 +117,13 @@ private:
     /** Print the column generation table's column header row on its own. */
     void print_column_generation_table_header();
 
+    /**
+     * Write a "Node" event, completed with the time, the value and the
+     * bound, if there is an event stream writer.
+     */
+    void write_node_event(
+            nlohmann::json event);
+
     /*
      * Private attributes
      */
@@ -115,6 +139,9 @@ private:
     /** Output stream. */
     std::unique_ptr<optimizationtools::ComposeStream> os_;
 
+    /** Time of the last print of the memory usage. */
+    double memory_usage_log_time_ = 0.0;
+
 };
 
 }
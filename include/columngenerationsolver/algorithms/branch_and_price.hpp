@@ -1,6 +1,7 @@
 #pragma once
 
 #include "columngenerationsolver/algorithms/column_generation.hpp"
+#include "columngenerationsolver/algorithms/lagrangian_relaxation.hpp"
 
 namespace columngenerationsolver
 {
@@ -32,6 +33,58 @@ struct BranchAndPriceParameters: Parameters
      */
     Counter strong_branching_maximum_number_of_iterations = 20;
 
+    /**
+     * Strong-branch evaluate the children with 'lagrangian_relaxation'
+     * (capped at 'strong_branching_maximum_number_of_iterations'
+     * iterations, warm-started from the duals of the node) instead of with
+     * 'column_generation'. Much cheaper, since no master LP is solved, but
+     * gives looser bounds.
+     */
+    bool lagrangian_strong_branching = false;
+
+    /**
+     * Enable reduced-cost fixing: once a node has converged and an
+     * incumbent exists, every pooled column whose reduced cost at the
+     * node's final duals exceeds the gap between the incumbent and the
+     * node's bound is excluded from the master LP of the whole subtree
+     * below that node.
+     */
+    bool reduced_cost_fixing = true;
+
+    /**
+     * Maximum relative gap for plunging (-1: no plunging, pure best-bound
+     * search).
+     *
+     * Once a node has been branched on, the search continues with its
+     * most promising child rather than with the best-bound open node as
+     * long as the child's bound is within this relative gap of the best
+     * bound. Consecutive nodes of a dive solve nested subproblems, so they
+     * keep reusing the same master LP, only applying the effects of the
+     * new branching decision (see 'ColumnGenerationParameters::master').
+     */
+    Value plunging_maximum_relative_gap = 0.05;
+
+    /**
+     * Memory budget of the open nodes, in bytes (-1: no limit).
+     *
+     * Open nodes only store what differs from their parent (branching
+     * decisions, ids of the columns and cuts to warm-start them with).
+     * When they still exceed this budget, the warm-start data of the least
+     * promising ones is written to 'open_nodes_spill_path' and read back
+     * when they are selected.
+     */
+    Counter open_nodes_memory_limit = -1;
+
+    /** Path of the file open nodes are spilled to (empty: no spilling). */
+    std::string open_nodes_spill_path = "";
+
+    /**
+     * Tailing-off criterion of the column generation calls other than the
+     * one of the root node, which uses
+     * 'column_generation_parameters.tailing_off'.
+     */
+    TailingOffParameters non_root_tailing_off;
+
 
     virtual int format_width() const override { return 47; }
 
@@ -42,6 +95,14 @@ struct BranchAndPriceParameters: Parameters
         os
             << std::setw(width) << std::left << "Maximum number of branching candidates: " << maximum_number_of_branching_candidates << std::endl
             << std::setw(width) << std::left << "Strong branching maximum number of iterations: " << strong_branching_maximum_number_of_iterations << std::endl
+            << std::setw(width) << std::left << "Lagrangian strong branching: " << lagrangian_strong_branching << std::endl
+            << std::setw(width) << std::left << "Reduced cost fixing: " << reduced_cost_fixing << std::endl
+            << std::setw(width) << std::left << "Plunging maximum relative gap: " << plunging_maximum_relative_gap << std::endl
+            << std::setw(width) << std::left << "Open nodes memory limit: " << open_nodes_memory_limit << std::endl
+            << std::setw(width) << std::left << "Open nodes spill path: " << open_nodes_spill_path << std::endl
+            << std::setw(width) << std::left << "Non-root tailing-off window size: " << non_root_tailing_off.window_size << std::endl
+            << std::setw(width) << std::left << "Non-root tailing-off min. rel. improvement: " << non_root_tailing_off.minimum_relative_improvement << std::endl
+            << std::setw(width) << std::left << "Non-root tailing-off max. rel. gap: " << non_root_tailing_off.maximum_relative_gap << std::endl
             ;
     }
 
@@ -51,6 +112,12 @@ struct BranchAndPriceParameters: Parameters
         json.merge_patch({
                 {"MaximumNumberOfBranchingCandidates", maximum_number_of_branching_candidates},
                 {"StrongBranchingMaximumNumberOfIterations", strong_branching_maximum_number_of_iterations},
+                {"LagrangianStrongBranching", lagrangian_strong_branching},
+                {"ReducedCostFixing", reduced_cost_fixing},
+                {"PlungingMaximumRelativeGap", plunging_maximum_relative_gap},
+                {"OpenNodesMemoryLimit", open_nodes_memory_limit},
+                {"OpenNodesSpillPath", open_nodes_spill_path},
+                {"NonRootTailingOff", non_root_tailing_off.to_json()},
                 });
         return json;
     }
@@ -72,6 +139,24 @@ struct BranchAndPriceOutput: Output
     /** Number of branching candidates strong-branch evaluated. */
     Counter number_of_branching_candidates_evaluated = 0;
 
+    /**
+     * Number of columns excluded by reduced-cost fixing, summed over the
+     * nodes where it happened.
+     */
+    Counter number_of_reduced_cost_fixed_columns = 0;
+
+    /**
+     * Number of nodes selected by plunging rather than by best bound (see
+     * 'BranchAndPriceParameters::plunging_maximum_relative_gap').
+     */
+    Counter number_of_plunged_nodes = 0;
+
+    /**
+     * Number of open nodes spilled to disk (see
+     * 'BranchAndPriceParameters::open_nodes_memory_limit').
+     */
+    Counter number_of_spilled_nodes = 0;
+
     /**
      * 'true' iff the open-node queue was exhausted, i.e. the returned
      * solution (if any) is proven optimal. 'false' means the search was cut
@@ -91,6 +176,9 @@ struct BranchAndPriceOutput: Output
             << std::setw(width) << std::left << "Number of nodes: " << number_of_nodes << std::endl
             << std::setw(width) << std::left << "Maximum depth: " << maximum_depth << std::endl
             << std::setw(width) << std::left << "Number of branching candidates evaluated: " << number_of_branching_candidates_evaluated << std::endl
+            << std::setw(width) << std::left << "Number of reduced-cost fixed columns: " << number_of_reduced_cost_fixed_columns << std::endl
+            << std::setw(width) << std::left << "Number of plunged nodes: " << number_of_plunged_nodes << std::endl
+            << std::setw(width) << std::left << "Number of spilled nodes: " << number_of_spilled_nodes << std::endl
             << std::setw(width) << std::left << "Optimal: " << optimal << std::endl
             ;
     }
@@ -102,6 +190,9 @@ struct BranchAndPriceOutput: Output
                 {"NumberOfNodes", number_of_nodes},
                 {"MaximumDepth", maximum_depth},
                 {"NumberOfBranchingCandidatesEvaluated", number_of_branching_candidates_evaluated},
+                {"NumberOfReducedCostFixedColumns", number_of_reduced_cost_fixed_columns},
+                {"NumberOfPlungedNodes", number_of_plunged_nodes},
+                {"NumberOfSpilledNodes", number_of_spilled_nodes},
                 {"Optimal", optimal},
                 });
         return json;
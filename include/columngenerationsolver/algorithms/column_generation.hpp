@@ -1,6 +1,7 @@
 #pragma once
 
 #include "columngenerationsolver/commons.hpp"
+#include "columngenerationsolver/iteration_trace.hpp"
 
 #include <unordered_set>
 
@@ -73,8 +74,97 @@ struct ColumnGenerationOutput: Output
      */
     std::vector<std::shared_ptr<const Cut>> cuts;
 
+    /**
+     * Row duals of the last master LP solve, once the optimality phase has
+     * converged, i.e. the last pricing call was made at these exact duals
+     * (no smoothing left) and found no improving column. Indexed like
+     * 'Model::rows' (0 for the rows already satisfied by the fixed
+     * columns). Empty if the call stopped before converging.
+     */
+    std::vector<Value> duals;
+
+    /** Cut duals matching 'duals'. */
+    std::vector<std::pair<std::shared_ptr<const Cut>, Value>> cut_duals;
+
+    /**
+     * Dual bound obtained at 'duals' alone ('relaxation_solution_value'
+     * plus the 'overcost' of the last pricing call; -inf (minimization) or
+     * +inf (maximization) if that call didn't provide one). Reduced-cost
+     * arguments (e.g. reduced-cost fixing in 'branch_and_price') must use
+     * this rather than 'bound', which is the best bound over all
+     * iterations and so isn't necessarily attained at 'duals'.
+     */
+    Value duals_bound = 0.0;
 
-    virtual int format_width() const override { return 37; }
+    /**
+     * Stability center of the dual smoothing at the end of the last
+     * optimality phase (its last separation point), indexed like
+     * 'Model::rows'. If no optimality phase has been run, the initial one
+     * (see 'ColumnGenerationParameters::initial_stability_center').
+     *
+     * Can be passed back through
+     * 'ColumnGenerationParameters::initial_stability_center' to warm-start
+     * the smoothing of a related call, e.g. for the children of a node.
+     */
+    std::vector<Value> stability_center;
+
+    /**
+     * Wentges smoothing parameter (alpha) at the end of the last
+     * optimality phase, after self-adjustment. If no optimality phase has
+     * been run, the initial one (see
+     * 'ColumnGenerationParameters::initial_wentges_smoothing_parameter').
+     */
+    Value wentges_smoothing_parameter = -1;
+
+    /**
+     * Number of moves of the stability center of the penalty stabilization
+     * (see 'ColumnGenerationParameters::penalty_stabilization').
+     */
+    Counter number_of_stability_center_updates = 0;
+
+    /**
+     * Number of decreases of the penalty of the penalty stabilization (see
+     * 'ColumnGenerationParameters::penalty_stabilization').
+     */
+    Counter number_of_penalty_updates = 0;
+
+    /**
+     * Number of times the dual-optimal inequalities had to be removed from
+     * the master LP because its solution still used them at convergence
+     * (see 'Model::dual_optimal_inequalities').
+     */
+    Counter number_of_dual_optimal_inequality_removals = 0;
+
+    /**
+     * Number of master LP solves done with an interior point method (see
+     * 'ColumnGenerationParameters::interior_point').
+     */
+    Counter number_of_interior_point_solves = 0;
+
+    /**
+     * Number of pricing calls interrupted by their time budget (see
+     * 'ColumnGenerationParameters::pricing_time_budget').
+     */
+    Counter number_of_interrupted_pricings = 0;
+
+    /**
+     * Number of pricing calls cancelled because a concurrent call for
+     * another pricing level returned columns first (see
+     * 'ColumnGenerationParameters::concurrent_pricing_levels').
+     */
+    Counter number_of_cancelled_pricings = 0;
+
+    /**
+     * 'true' iff the optimality phase was stopped before convergence by the
+     * tailing-off criterion (see 'ColumnGenerationParameters::tailing_off').
+     * 'relaxation_solution' is then a feasible but not necessarily optimal
+     * solution of the relaxation, and 'duals' is empty; 'bound' is still
+     * valid.
+     */
+    bool tailing_off = false;
+
+
+    virtual int format_width() const override { return 45; }
 
     virtual void format(std::ostream& os) const override
     {
@@ -86,8 +176,15 @@ struct ColumnGenerationOutput: Output
             << std::setw(width) << std::left << "Number of first-try pricings: " << number_of_first_try_pricings << std::endl
             << std::setw(width) << std::left << "Number of mispricings: " << number_of_mispricings << std::endl
             << std::setw(width) << std::left << "Number of no-stab pricings: " << number_of_no_stab_pricings << std::endl
+            << std::setw(width) << std::left << "Number of stability center updates: " << number_of_stability_center_updates << std::endl
+            << std::setw(width) << std::left << "Number of penalty updates: " << number_of_penalty_updates << std::endl
+            << std::setw(width) << std::left << "Number of dual-optimal inequality removals: " << number_of_dual_optimal_inequality_removals << std::endl
+            << std::setw(width) << std::left << "Number of interior point solves: " << number_of_interior_point_solves << std::endl
+            << std::setw(width) << std::left << "Number of interrupted pricings: " << number_of_interrupted_pricings << std::endl
+            << std::setw(width) << std::left << "Number of cancelled pricings: " << number_of_cancelled_pricings << std::endl
             << std::setw(width) << std::left << "Number of cutting-plane iterations: " << number_of_cutting_plane_iterations << std::endl
             << std::setw(width) << std::left << "Number of cuts: " << cuts.size() << std::endl
+            << std::setw(width) << std::left << "Tailing off: " << tailing_off << std::endl
             ;
     }
 
@@ -100,8 +197,15 @@ struct ColumnGenerationOutput: Output
                 {"NumberOfFirstTryPricings", number_of_first_try_pricings},
                 {"NumberOfMispricings", number_of_mispricings},
                 {"NumberOfNoStabPricings", number_of_no_stab_pricings},
+                {"NumberOfStabilityCenterUpdates", number_of_stability_center_updates},
+                {"NumberOfPenaltyUpdates", number_of_penalty_updates},
+                {"NumberOfDualOptimalInequalityRemovals", number_of_dual_optimal_inequality_removals},
+                {"NumberOfInteriorPointSolves", number_of_interior_point_solves},
+                {"NumberOfInterruptedPricings", number_of_interrupted_pricings},
+                {"NumberOfCancelledPricings", number_of_cancelled_pricings},
                 {"NumberOfCuttingPlaneIterations", number_of_cutting_plane_iterations},
                 {"NumberOfCuts", cuts.size()},
+                {"TailingOff", tailing_off},
                 });
         return json;
     }
@@ -118,6 +222,71 @@ using ColumnGenerationPhaseCallback = std::function<void(bool solve_feasibility)
 /** Called once at the start of each cutting-plane round. */
 using ColumnGenerationCuttingPlaneCallback = std::function<void(Counter cutting_plane_iteration)>;
 
+/**
+ * Optimality-phase master LP kept alive across 'column_generation()' calls
+ * (see 'ColumnGenerationParameters::master'). Opaque: only
+ * 'column_generation()' reads or modifies it.
+ */
+struct ColumnGenerationMaster;
+
+/** Create an empty master LP, to be filled by the first call using it. */
+std::shared_ptr<ColumnGenerationMaster> create_column_generation_master();
+
+/**
+ * Contribution of the fixed columns to the rows and to the objective, for
+ * callers which maintain it incrementally (see
+ * 'ColumnGenerationParameters::fixed_columns_contribution').
+ */
+struct FixedColumnsContribution
+{
+    /** Value of each row. */
+    std::vector<Value> row_values;
+
+    /** Objective value. */
+    Value objective_value = 0.0;
+};
+
+/**
+ * Criterion to stop the optimality phase of column generation early, once
+ * the relaxation barely improves any more.
+ *
+ * Meant for heuristic tree searches, for which a nearly converged
+ * relaxation is good enough, and which may use different criteria for the
+ * root node and for the other nodes.
+ */
+struct TailingOffParameters
+{
+    /**
+     * Number of iterations of the sliding window (0: disabled).
+     *
+     * Stop if the value of the relaxation solution has improved by less
+     * than 'minimum_relative_improvement' (relative to its current value)
+     * over the last 'window_size' iterations.
+     */
+    Counter window_size = 0;
+
+    /** Minimum relative improvement over the sliding window. */
+    Value minimum_relative_improvement = 1e-4;
+
+    /**
+     * Maximum relative gap between the value of the relaxation solution and
+     * the bound (-1: disabled).
+     *
+     * Stop as soon as the gap is smaller.
+     */
+    Value maximum_relative_gap = -1;
+
+
+    nlohmann::json to_json() const
+    {
+        return nlohmann::json{
+            {"WindowSize", window_size},
+            {"MinimumRelativeImprovement", minimum_relative_improvement},
+            {"MaximumRelativeGap", maximum_relative_gap},
+        };
+    }
+};
+
 struct ColumnGenerationParameters: Parameters
 {
     /** Linear programming solver. */
@@ -149,6 +318,63 @@ struct ColumnGenerationParameters: Parameters
      */
     Value optimality_tolerance = 0.0;
 
+    /**
+     * Maximum number of columns added to the LP at each iteration (-1: no
+     * limit). The columns with the best reduced costs are selected (see
+     * 'column_selection_diversity'); the others stay in the column pool.
+     */
+    Counter maximum_number_of_columns_per_iteration = -1;
+
+    /**
+     * Adapt the maximum number of columns added to the LP at each iteration
+     * to the time spent in the LP solves compared to the pricing: it
+     * increases while the pricing takes longer than the LP solve, and
+     * decreases otherwise, without exceeding
+     * 'maximum_number_of_columns_per_iteration' if set. Starts at the
+     * number of rows if not set.
+     */
+    bool adaptive_number_of_columns_per_iteration = false;
+
+    /**
+     * Weight, in [0, 1], of the diversity of the selected columns: the
+     * improvement of a candidate column is multiplied by
+     * '1 - column_selection_diversity * overlap', where 'overlap' is the
+     * fraction of its rows already covered by the columns selected before
+     * it. Only used when the number of columns is limited.
+     */
+    Value column_selection_diversity = 0.0;
+
+    /**
+     * Initial time budget of each call to the pricing solver, in seconds
+     * (negative: none, only the remaining time), passed through
+     * 'PricingContext'. Meant for heuristic pricing solvers, so that they
+     * don't spend long on iterations where any column would do.
+     *
+     * When a call gets interrupted without returning any column, it is
+     * called again with a budget multiplied by
+     * 'pricing_time_budget_growth_factor', for the rest of the attempt: the
+     * budget stays small while columns are easy to find, and grows close to
+     * convergence.
+     */
+    double pricing_time_budget = -1;
+
+    /** Growth factor of the time budget of the pricing calls. */
+    double pricing_time_budget_growth_factor = 2;
+
+    /**
+     * Call the pricing solver for all the pricing levels at once, each in
+     * its own thread, instead of escalating through them one at a time.
+     *
+     * The columns of the first call returning some are used, and the other
+     * calls are cancelled through 'PricingContext::cancel'. The most
+     * thorough level, which provides the bound, is only waited for when no
+     * call returns any column.
+     *
+     * Only used if 'PricingSolver::supports_concurrent_pricing_levels'
+     * returns 'true', and not for the internal diving pricing calls.
+     */
+    bool concurrent_pricing_levels = false;
+
     /** Callback function called at each column generation iteration. */
     ColumnGenerationIterationCallback iteration_callback = [](const Output&) { };
 
@@ -158,6 +384,21 @@ struct ColumnGenerationParameters: Parameters
     /** Callback function called at the start of each cutting-plane round. */
     ColumnGenerationCuttingPlaneCallback cutting_plane_callback = [](Counter) { };
 
+    /**
+     * Writer of the statistics of each iteration ('nullptr': none). The
+     * tree search algorithms pass it on to the column generation of each of
+     * their nodes.
+     */
+    std::shared_ptr<IterationTraceWriter> iteration_trace_writer = nullptr;
+
+    /**
+     * Id of the node of the tree search this call is run for, attached to
+     * the records of 'iteration_trace_writer' (-1: none). Set by the tree
+     * search algorithms; strong-branching evaluations get the id of the
+     * node being branched on.
+     */
+    Counter node_id = -1;
+
     /*
      * Stabilization parameters
      */
@@ -174,6 +415,86 @@ struct ColumnGenerationParameters: Parameters
     /** Enable automatic directional smoothing. */
     bool automatic_directional_smoothing = false;
 
+    /**
+     * Initial stability center of the dual smoothing, indexed like
+     * 'Model::rows' (empty: zero), e.g. the 'stability_center' of the
+     * parent node.
+     */
+    std::vector<Value> initial_stability_center;
+
+    /**
+     * Initial Wentges smoothing parameter when it is self-adjusting (-1:
+     * 'static_wentges_smoothing_parameter'), e.g. the
+     * 'wentges_smoothing_parameter' of the parent node.
+     */
+    Value initial_wentges_smoothing_parameter = -1;
+
+    /**
+     * Enable penalty stabilization (box-step with penalties, du Merle et
+     * al., 1999) in the optimality phase.
+     *
+     * Two artificial columns are added to the master LP for each row, with
+     * coefficients +1 and -1, bounded by the penalty, and whose costs
+     * confine the duals to the box of half-width
+     * 'penalty_stabilization_box_half_width' around a stability center:
+     * leaving the box costs the penalty per unit. The center moves to the
+     * separation point each time the bound improves. Once no column is
+     * found while some artificial column is still used, the center moves
+     * to the current duals and the penalty is multiplied by
+     * 'penalty_stabilization_penalty_decrease_factor', down to 0, so that
+     * the procedure converges to the unstabilized master. Can be combined
+     * with smoothing, which then applies around the duals of the penalized
+     * master.
+     */
+    bool penalty_stabilization = false;
+
+    /** Half-width of the box around the stability center. */
+    Value penalty_stabilization_box_half_width = 1.0;
+
+    /** Initial penalty (upper bound of the artificial columns). */
+    Value penalty_stabilization_initial_penalty = 1.0;
+
+    /** Factor the penalty is multiplied by at each decrease. */
+    Value penalty_stabilization_penalty_decrease_factor = 0.1;
+
+    /**
+     * Add the dual-optimal inequalities of the model, if any, to the master
+     * LP of the optimality phase (see 'Model::dual_optimal_inequalities').
+     */
+    bool dual_optimal_inequalities = true;
+
+    /**
+     * Solve the master LP of the optimality phase with an interior point
+     * method without crossover (primal-dual column generation, Gondzio et
+     * al., 2013): its duals are well centered, so they don't oscillate
+     * like the extreme-point duals of the simplex.
+     *
+     * The relative optimality tolerance of each solve is the relative gap
+     * between the relaxation value and the bound divided by
+     * 'interior_point_gap_factor', at most
+     * 'interior_point_maximum_tolerance'. Since the duals aren't optimal,
+     * the bound is then computed from the Lagrangian function at the
+     * duals given to the pricing solver. Once the tolerance falls below
+     * 'interior_point_minimum_tolerance', or once no column is found, the
+     * master is solved with the simplex until convergence.
+     *
+     * The tolerance is ignored by CLP, and Knitro always uses its own
+     * algorithm.
+     */
+    bool interior_point = false;
+
+    /** Maximum relative optimality tolerance of the interior point solves. */
+    Value interior_point_maximum_tolerance = 0.5;
+
+    /** Factor the relative gap is divided by to get the tolerance. */
+    Value interior_point_gap_factor = 10;
+
+    /** Tolerance below which the simplex is used. */
+    Value interior_point_minimum_tolerance = 1e-6;
+
+    /** Tailing-off criterion of the optimality phase. */
+    TailingOffParameters tailing_off;
+
 
     /**
      * Tabu columns.
@@ -183,6 +504,54 @@ struct ColumnGenerationParameters: Parameters
      */
     std::unordered_set<std::shared_ptr<const Column>>* tabu = nullptr;
 
+    /**
+     * Column pool shared with the caller.
+     *
+     * If set, it is used instead of 'column_pool', without being copied:
+     * the columns generated by this call are added to it, and the columns
+     * it contains which are infeasible for 'fixed_columns' are only
+     * skipped while scanning it. Meant for tree searches, which keep a
+     * single pool for all their nodes.
+     */
+    ColumnPool* shared_column_pool = nullptr;
+
+    /**
+     * Contribution of 'fixed_columns' to the rows and to the objective.
+     *
+     * If set, it must match 'fixed_columns' and is used instead of
+     * recomputing it from them. Meant for tree searches which update it
+     * incrementally from one node to the next.
+     */
+    const FixedColumnsContribution* fixed_columns_contribution = nullptr;
+
+    /**
+     * Gap between the best known solution and the dual bound of the node
+     * being solved, passed through to 'PricingSolver::initialize_pricing'
+     * (infinity: no incumbent, or not known).
+     */
+    Value reduced_cost_fixing_gap = std::numeric_limits<Value>::infinity();
+
+    /**
+     * Optimality-phase master LP to reuse.
+     *
+     * If it was last built for exactly the same rows, row bounds and cuts,
+     * the optimality phase reuses it in place (keeping the solver's warm
+     * start) instead of building a new one: the columns it already holds
+     * which have become infeasible (e.g. because of a new branching
+     * decision or a new tabu column) are only disabled through their
+     * bounds, the ones which have become feasible again are re-enabled,
+     * and only the missing initial columns are added. Otherwise, it is
+     * replaced by the newly built LP, for the next call to reuse.
+     *
+     * Meant for consecutive calls on nested subproblems, e.g. a dive in
+     * 'branch_and_price': the LP keeps every column added since it was
+     * created, so it should be dropped when jumping elsewhere.
+     *
+     * 'nullptr': the LP is only reused within this call (across pricing
+     * levels).
+     */
+    std::shared_ptr<ColumnGenerationMaster> master = nullptr;
+
     /**
      * Fraction of the starting infeasibility that must remain before the
      * rounding heuristic's greedy fixing phase stops and hands off to its
@@ -206,10 +575,30 @@ struct ColumnGenerationParameters: Parameters
             << std::setw(width) << std::left << "Static directional smoothing parameter: " << static_directional_smoothing_parameter << std::endl
             << std::setw(width) << std::left << "Self-adjusting Wentges smoothing: " << self_adjusting_wentges_smoothing << std::endl
             << std::setw(width) << std::left << "Automatic directional smoothing: " << automatic_directional_smoothing << std::endl
+            << std::setw(width) << std::left << "Penalty stabilization: " << penalty_stabilization << std::endl
+            << std::setw(width) << std::left << "Penalty stabilization box half-width: " << penalty_stabilization_box_half_width << std::endl
+            << std::setw(width) << std::left << "Penalty stabilization initial penalty: " << penalty_stabilization_initial_penalty << std::endl
+            << std::setw(width) << std::left << "Penalty stabilization decrease factor: " << penalty_stabilization_penalty_decrease_factor << std::endl
+            << std::setw(width) << std::left << "Dual-optimal inequalities: " << dual_optimal_inequalities << std::endl
+            << std::setw(width) << std::left << "Interior point: " << interior_point << std::endl
+            << std::setw(width) << std::left << "Interior point maximum tolerance: " << interior_point_maximum_tolerance << std::endl
+            << std::setw(width) << std::left << "Interior point gap factor: " << interior_point_gap_factor << std::endl
+            << std::setw(width) << std::left << "Interior point minimum tolerance: " << interior_point_minimum_tolerance << std::endl
+            << std::setw(width) << std::left << "Tailing-off window size: " << tailing_off.window_size << std::endl
+            << std::setw(width) << std::left << "Tailing-off minimum relative improvement: " << tailing_off.minimum_relative_improvement << std::endl
+            << std::setw(width) << std::left << "Tailing-off maximum relative gap: " << tailing_off.maximum_relative_gap << std::endl
             << std::setw(width) << std::left << "Maximum number of iterations: " << maximum_number_of_iterations << std::endl
             << std::setw(width) << std::left << "Maximum number of cutting-plane iterations: " << maximum_number_of_cutting_plane_iterations << std::endl
             << std::setw(width) << std::left << "Optimality tolerance: " << optimality_tolerance << std::endl
+            << std::setw(width) << std::left << "Maximum number of columns per iteration: " << maximum_number_of_columns_per_iteration << std::endl
+            << std::setw(width) << std::left << "Adaptive number of columns per iteration: " << adaptive_number_of_columns_per_iteration << std::endl
+            << std::setw(width) << std::left << "Column selection diversity: " << column_selection_diversity << std::endl
+            << std::setw(width) << std::left << "Pricing time budget: " << pricing_time_budget << std::endl
+            << std::setw(width) << std::left << "Pricing time budget growth factor: " << pricing_time_budget_growth_factor << std::endl
+            << std::setw(width) << std::left << "Concurrent pricing levels: " << concurrent_pricing_levels << std::endl
             << std::setw(width) << std::left << "Tabu size: " << (tabu == nullptr? 0: tabu->size()) << std::endl
+            << std::setw(width) << std::left << "Shared column pool size: " << (shared_column_pool == nullptr? 0: shared_column_pool->number_of_columns()) << std::endl
+            << std::setw(width) << std::left << "Reduced cost fixing gap: " << reduced_cost_fixing_gap << std::endl
             << std::setw(width) << std::left << "Rounding heuristic infeasibility threshold: " << rounding_heuristic_infeasibility_threshold << std::endl
             ;
     }
@@ -223,10 +612,28 @@ struct ColumnGenerationParameters: Parameters
                 {"StaticDirectionalSmoothingParameter", static_directional_smoothing_parameter},
                 {"SelfAdjustingWentgesSmoothing", self_adjusting_wentges_smoothing},
                 {"AutomaticDirectionalSmoothing", automatic_directional_smoothing},
+                {"PenaltyStabilization", penalty_stabilization},
+                {"PenaltyStabilizationBoxHalfWidth", penalty_stabilization_box_half_width},
+                {"PenaltyStabilizationInitialPenalty", penalty_stabilization_initial_penalty},
+                {"PenaltyStabilizationPenaltyDecreaseFactor", penalty_stabilization_penalty_decrease_factor},
+                {"DualOptimalInequalities", dual_optimal_inequalities},
+                {"InteriorPoint", interior_point},
+                {"InteriorPointMaximumTolerance", interior_point_maximum_tolerance},
+                {"InteriorPointGapFactor", interior_point_gap_factor},
+                {"InteriorPointMinimumTolerance", interior_point_minimum_tolerance},
+                {"TailingOff", tailing_off.to_json()},
                 {"MaximumNumberOfIterations", maximum_number_of_iterations},
                 {"MaximumNumberOfCuttingPlaneIterations", maximum_number_of_cutting_plane_iterations},
                 {"OptimalityTolerance", optimality_tolerance},
+                {"MaximumNumberOfColumnsPerIteration", maximum_number_of_columns_per_iteration},
+                {"AdaptiveNumberOfColumnsPerIteration", adaptive_number_of_columns_per_iteration},
+                {"ColumnSelectionDiversity", column_selection_diversity},
+                {"PricingTimeBudget", pricing_time_budget},
+                {"PricingTimeBudgetGrowthFactor", pricing_time_budget_growth_factor},
+                {"ConcurrentPricingLevels", concurrent_pricing_levels},
                 {"TabuSize", (tabu == nullptr? 0: tabu->size())},
+                {"SharedColumnPoolSize", (shared_column_pool == nullptr? 0: shared_column_pool->number_of_columns())},
+                {"ReducedCostFixingGap", reduced_cost_fixing_gap},
                 {"RoundingHeuristicInfeasibilityThreshold", rounding_heuristic_infeasibility_threshold},
                 });
         return json;
@@ -237,4 +644,77 @@ const ColumnGenerationOutput column_generation(
         const Model& model,
         const ColumnGenerationParameters& parameters = {});
 
+/** Temporary vectors of 'compute_separation_point', indexed like 'Model::rows'. */
+struct SeparationPointWorkspace
+{
+    /** π_in + (1 − α) (π_out − π_in). */
+    std::vector<Value> duals_tilde;
+
+    /** Duals in the direction of the subgradient. */
+    std::vector<Value> duals_g;
+
+    /** β π_g + (1 − β) π_out. */
+    std::vector<Value> rho;
+};
+
+/**
+ * Compute the separation point 'duals_sep' of the smoothing stabilization
+ * on the rows 'new_rows' (Pessoa et al., 2018): the Wentges smoothing of
+ * 'duals_in' and 'duals_out' with parameter 'alpha', turned towards the
+ * direction of 'subgradient' if 'directional_smoothing' is set.
+ *
+ * With directional smoothing, 'beta' is the directional smoothing
+ * parameter if 'automatic_directional_smoothing' is 'false', otherwise it
+ * is computed from the angle between 'duals_out - duals_in' and the
+ * subgradient. The norms of 'subgradient' and 'duals_out - duals_in' must
+ * then be positive. Return the directional smoothing parameter used.
+ */
+Value compute_separation_point(
+        const std::vector<RowIdx>& new_rows,
+        const std::vector<Value>& duals_in,
+        const std::vector<Value>& duals_out,
+        const std::vector<Value>& subgradient,
+        Value alpha,
+        bool directional_smoothing,
+        bool automatic_directional_smoothing,
+        Value beta,
+        SeparationPointWorkspace& workspace,
+        std::vector<Value>& duals_sep);
+
+/**
+ * Append to 'new_columns' the columns of 'column_pool' whose reduced cost
+ * at 'duals' and 'cut_duals' improves by more than 'optimality_tolerance',
+ * among the ones for which 'is_candidate(column_id, column)' returns
+ * 'true'.
+ *
+ * This is the scan of the column pool done by 'column_generation' at each
+ * iteration before calling the pricing solver.
+ */
+template <typename IsCandidate>
+void scan_column_pool(
+        const Model& model,
+        const ColumnPool& column_pool,
+        bool solve_feasibility,
+        const std::vector<Value>& duals,
+        const std::vector<std::pair<std::shared_ptr<const Cut>, Value>>& cut_duals,
+        Value optimality_tolerance,
+        const IsCandidate& is_candidate,
+        std::vector<std::shared_ptr<const Column>>& new_columns)
+{
+    bool minimize = (model.objective_sense == optimizationtools::ObjectiveDirection::Minimize);
+    for (ColIdx column_id = 0;
+            column_id < column_pool.number_of_columns();
+            ++column_id) {
+        const std::shared_ptr<const Column>& column = column_pool.column(column_id);
+        if (!is_candidate(column_id, column))
+            continue;
+        Value rc = model.compute_reduced_cost(solve_feasibility, *column, duals, cut_duals);
+        if ((minimize)?
+                rc < -optimality_tolerance:
+                rc > optimality_tolerance) {
+            new_columns.push_back(column);
+        }
+    }
+}
+
 }
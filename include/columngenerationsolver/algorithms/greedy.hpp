@@ -10,21 +10,32 @@ struct GreedyParameters: Parameters
     /** Parameters for the column generation sub-problem. */
     ColumnGenerationParameters column_generation_parameters;
 
+    /**
+     * Tailing-off criterion of the column generation calls after the first
+     * one, which uses 'column_generation_parameters.tailing_off'.
+     */
+    TailingOffParameters non_root_tailing_off;
 
-    virtual int format_width() const override { return 41; }
+
+    virtual int format_width() const override { return 45; }
 
     virtual void format(std::ostream& os) const override
     {
         Parameters::format(os);
-        //int width = format_width();
-        //os
-        //    ;
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Non-root tailing-off window size: " << non_root_tailing_off.window_size << std::endl
+            << std::setw(width) << std::left << "Non-root tailing-off min. rel. improvement: " << non_root_tailing_off.minimum_relative_improvement << std::endl
+            << std::setw(width) << std::left << "Non-root tailing-off max. rel. gap: " << non_root_tailing_off.maximum_relative_gap << std::endl
+            ;
     }
 
     virtual nlohmann::json to_json() const override
     {
         nlohmann::json json = Parameters::to_json();
-        json.merge_patch({});
+        json.merge_patch({
+                {"NonRootTailingOff", non_root_tailing_off.to_json()},
+                });
         return json;
     }
 };
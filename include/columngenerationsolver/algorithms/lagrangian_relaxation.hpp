@@ -0,0 +1,165 @@
+#pragma once
+
+#include "columngenerationsolver/commons.hpp"
+
+namespace columngenerationsolver
+{
+
+struct LagrangianRelaxationOutput: Output
+{
+    /** Constructor. */
+    LagrangianRelaxationOutput(const Model& model):
+        Output(model) { }
+
+
+    /**
+     * Duals at which 'bound' has been obtained, indexed like 'Model::rows'
+     * (0 for the rows already satisfied by the fixed columns).
+     */
+    std::vector<Value> duals;
+
+    /** Number of iterations. */
+    Counter number_of_iterations = 0;
+
+    /** Number of times the step size has been decreased. */
+    Counter number_of_step_size_decreases = 0;
+
+    /**
+     * 'false' iff the pricing solver didn't give the multiplicities of its
+     * columns (see 'PricingSolver::PricingOutput::lagrangian_column_multiplicities'),
+     * in which case 'relaxation_solution' is empty.
+     */
+    bool has_primal_solution = true;
+
+
+    virtual int format_width() const override { return 33; }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Output::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Number of iterations: " << number_of_iterations << std::endl
+            << std::setw(width) << std::left << "Number of step size decreases: " << number_of_step_size_decreases << std::endl
+            << std::setw(width) << std::left << "Has primal solution: " << has_primal_solution << std::endl
+            ;
+    }
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Output::to_json();
+        json.merge_patch({
+                {"NumberOfIterations", number_of_iterations},
+                {"NumberOfStepSizeDecreases", number_of_step_size_decreases},
+                {"HasPrimalSolution", has_primal_solution},
+                });
+        return json;
+    }
+};
+
+struct LagrangianRelaxationParameters: Parameters
+{
+    /** Maximum number of iterations. */
+    Counter maximum_number_of_iterations = 100;
+
+    /**
+     * Initial duals, indexed like 'Model::rows' (empty: zero), e.g. the
+     * duals of the parent node.
+     */
+    std::vector<Value> initial_duals;
+
+    /**
+     * Volume parameter (alpha): weight of the last Lagrangian solution in
+     * the averaged primal solution, whose violation gives the direction of
+     * the next step. 1: plain subgradient method.
+     */
+    Value volume_parameter = 0.1;
+
+    /** Initial step size parameter (lambda). */
+    Value step_size_parameter = 0.5;
+
+    /**
+     * Number of consecutive iterations without improvement of the bound
+     * after which the step size parameter is halved.
+     */
+    Counter maximum_number_of_iterations_without_improvement = 10;
+
+    /**
+     * Relative gap between the bound and the target value of the step size
+     * formula, used as long as no better target is known.
+     */
+    Value target_relative_gap = 0.1;
+
+    /**
+     * Stop once the relative gap between the value of the averaged primal
+     * solution and the bound, and the maximum violation of the rows by the
+     * averaged primal solution, are both below this tolerance.
+     */
+    Value tolerance = 1e-3;
+
+    /** Pricing level (see 'PricingSolver::number_of_pricing_levels'). */
+    Counter pricing_level = 0;
+
+    /**
+     * Column pool shared with the caller (see
+     * 'ColumnGenerationParameters::shared_column_pool'). The columns
+     * returned by the pricing solver are added to it.
+     */
+    ColumnPool* shared_column_pool = nullptr;
+
+
+    virtual int format_width() const override { return 51; }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Parameters::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Maximum number of iterations: " << maximum_number_of_iterations << std::endl
+            << std::setw(width) << std::left << "Volume parameter: " << volume_parameter << std::endl
+            << std::setw(width) << std::left << "Step size parameter: " << step_size_parameter << std::endl
+            << std::setw(width) << std::left << "Maximum number of iterations without improvement: " << maximum_number_of_iterations_without_improvement << std::endl
+            << std::setw(width) << std::left << "Target relative gap: " << target_relative_gap << std::endl
+            << std::setw(width) << std::left << "Tolerance: " << tolerance << std::endl
+            << std::setw(width) << std::left << "Pricing level: " << pricing_level << std::endl
+            ;
+    }
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Parameters::to_json();
+        json.merge_patch({
+                {"MaximumNumberOfIterations", maximum_number_of_iterations},
+                {"VolumeParameter", volume_parameter},
+                {"StepSizeParameter", step_size_parameter},
+                {"MaximumNumberOfIterationsWithoutImprovement", maximum_number_of_iterations_without_improvement},
+                {"TargetRelativeGap", target_relative_gap},
+                {"Tolerance", tolerance},
+                {"PricingLevel", pricing_level},
+                });
+        return json;
+    }
+};
+
+/**
+ * Solve the Lagrangian dual of the linear relaxation with the volume
+ * algorithm (Barahona and Anbil, 2000), without any master LP: only the
+ * pricing solver is called, at each iteration, at the current duals.
+ *
+ * 'bound' is the best Lagrangian bound found, obtained from the 'overcost'
+ * of the pricing solver (no bound if it doesn't provide one). The active
+ * cuts are relaxed. 'relaxation_solution' is the averaged primal solution:
+ * an approximately feasible fractional solution, built from the columns
+ * returned by the pricing solver, weighted by their multiplicities, and the
+ * static columns. It is empty if the pricing solver sets
+ * 'lagrangian_column_values' without 'lagrangian_column_multiplicities'.
+ *
+ * Much cheaper than 'column_generation' per iteration, and meant for quick
+ * bound estimates, e.g. to score strong-branching candidates (see
+ * 'BranchAndPriceParameters::lagrangian_strong_branching').
+ */
+const LagrangianRelaxationOutput lagrangian_relaxation(
+        const Model& model,
+        const LagrangianRelaxationParameters& parameters = {});
+
+}
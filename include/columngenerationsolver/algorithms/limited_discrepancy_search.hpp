@@ -20,8 +20,15 @@ struct LimitedDiscrepancySearchParameters: Parameters
     /** Parameters for the column generation sub-problem. */
     ColumnGenerationParameters column_generation_parameters;
 
+    /**
+     * Tailing-off criterion of the column generation calls other than the
+     * one of the root node, which uses
+     * 'column_generation_parameters.tailing_off'.
+     */
+    TailingOffParameters non_root_tailing_off;
 
-    virtual int format_width() const override { return 39; }
+
+    virtual int format_width() const override { return 45; }
 
     virtual void format(std::ostream& os) const override
     {
@@ -31,6 +38,9 @@ struct LimitedDiscrepancySearchParameters: Parameters
             << std::setw(width) << std::left << "Discrepancy limit: " << discrepancy_limit << std::endl
             << std::setw(width) << std::left << "Automatic stop: " << automatic_stop << std::endl
             << std::setw(width) << std::left << "Continue until feasible: " << continue_until_feasible << std::endl
+            << std::setw(width) << std::left << "Non-root tailing-off window size: " << non_root_tailing_off.window_size << std::endl
+            << std::setw(width) << std::left << "Non-root tailing-off min. rel. improvement: " << non_root_tailing_off.minimum_relative_improvement << std::endl
+            << std::setw(width) << std::left << "Non-root tailing-off max. rel. gap: " << non_root_tailing_off.maximum_relative_gap << std::endl
             ;
     }
 
@@ -41,6 +51,7 @@ struct LimitedDiscrepancySearchParameters: Parameters
                 {"DiscrepancyLimit", discrepancy_limit},
                 {"AutomaticStop", automatic_stop},
                 {"ContinueUntilFeasible", continue_until_feasible},
+                {"NonRootTailingOff", non_root_tailing_off.to_json()},
                 });
         return json;
     }
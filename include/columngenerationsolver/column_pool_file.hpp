@@ -0,0 +1,71 @@
+#pragma once
+
+#include "columngenerationsolver/commons.hpp"
+
+#include <functional>
+
+namespace columngenerationsolver
+{
+
+/**
+ * Function returning the bytes representing the 'extra' field of a column,
+ * written in a column pool file.
+ */
+using ColumnExtraSerializer = std::function<std::string(const Column&)>;
+
+/**
+ * Function building the 'extra' field of a column from the bytes written by
+ * a 'ColumnExtraSerializer'.
+ */
+using ColumnExtraDeserializer = std::function<std::shared_ptr<void>(const char* data, size_t size)>;
+
+/**
+ * Write columns to a column pool file, e.g. the columns of 'Output::columns'
+ * at the end of a run, to warm start the next runs on the same model with
+ * 'read_column_pool'.
+ *
+ * The file is a binary file in the native byte order. It starts with a
+ * header of 8 64-bit words:
+ * - the magic string "CGSPOOL" followed by the format version
+ * - a marker of the byte order
+ * - the number of rows
+ * - the number of columns n
+ * - the number of elements m
+ * - the size in bytes of the names
+ * - the size in bytes of the 'extra' fields
+ * - 0 (reserved)
+ *
+ * followed by arrays at fixed offsets computed from the header:
+ * - n objective coefficients, lower bounds, upper bounds and branching
+ *   priorities (doubles)
+ * - n + 1 positions of the first element of each column (int64)
+ * - m rows (int64), then m coefficients (doubles)
+ * - n + 1 positions of the first character of each name (int64)
+ * - n + 1 positions of the first byte of each 'extra' field (int64)
+ * - n types (1 byte, 1 for integer)
+ * - the names, then the 'extra' fields
+ *
+ * If 'serialize_extra' is not set, the 'extra' fields are not written.
+ */
+void write_column_pool(
+        const std::string& path,
+        RowIdx number_of_rows,
+        const std::vector<std::shared_ptr<const Column>>& columns,
+        const ColumnExtraSerializer& serialize_extra = nullptr);
+
+/**
+ * Read the columns of a column pool file written by 'write_column_pool',
+ * e.g. to set 'Parameters::column_pool'.
+ *
+ * Throw if the file is not a valid column pool file, or if it has been
+ * written for a model with a different number of rows.
+ *
+ * If 'deserialize_extra' is not set, the 'extra' fields of the columns
+ * read are empty.
+ */
+std::vector<std::shared_ptr<const Column>> read_column_pool(
+        const std::string& path,
+        const Model& model,
+        const ColumnExtraDeserializer& deserialize_extra = nullptr);
+
+}
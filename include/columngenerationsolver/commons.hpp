@@ -5,8 +5,11 @@
 #include "optimizationtools/containers/indexed_map.hpp"
 
 #include <vector>
+#include <unordered_map>
 #include <cstdint>
 #include <iomanip>
+#include <atomic>
+#include <chrono>
 
 namespace columngenerationsolver
 {
@@ -64,6 +67,17 @@ struct Column
     std::shared_ptr<void> extra;
 };
 
+/**
+ * Approximate memory used by a column, not counting its 'extra' field,
+ * which is opaque.
+ */
+inline Counter memory(const Column& column)
+{
+    return sizeof(Column)
+        + column.name.capacity()
+        + column.elements.capacity() * sizeof(LinearTerm);
+}
+
 inline std::ostream& operator<<(
         std::ostream& os,
         const Column& column)
@@ -221,6 +235,89 @@ struct BranchingCandidate
     Value score = 0.0;
 };
 
+/**
+ * Time budget and cancellation of a call to 'PricingSolver::solve_pricing'.
+ *
+ * A pricing solver which can stop early (e.g. a heuristic search) should
+ * check 'needs_to_end' regularly and, once it returns 'true', return the
+ * columns found so far with 'PricingOutput::interrupted' set. Ignoring it
+ * is always correct.
+ */
+struct PricingContext
+{
+    /** Time after which the call should end. */
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+
+    /**
+     * Remaining time of the whole algorithm when the call started, in
+     * seconds ('deadline' is never later).
+     */
+    double remaining_time = std::numeric_limits<double>::infinity();
+
+    /** Cancellation flag, which may be set from another thread. */
+    const std::atomic<bool>* cancel = nullptr;
+
+    /**
+     * Id of the pricing subproblem. It only changes when 'initialize_pricing'
+     * is called or when 'solve_feasibility' changes, so a pricing solver
+     * may keep the state it built for a generation (e.g. its subproblem
+     * instance) and only update it for the new duals.
+     */
+    Counter subproblem_generation = 0;
+
+    /**
+     * 'true' iff the previous call to 'solve_pricing' was for the same
+     * 'subproblem_generation', in which case 'changed_rows' is meaningful.
+     */
+    bool has_changed_rows = false;
+
+    /**
+     * Rows whose dual changed since the previous call to 'solve_pricing'
+     * (see 'has_changed_rows'). The 'cut_duals' are always given in full.
+     */
+    std::vector<RowIdx> changed_rows;
+
+
+    /**
+     * Create the context of a call with time budget 'time_budget' (in
+     * seconds, negative: none), within the remaining time of 'timer'.
+     */
+    static PricingContext create(
+            const optimizationtools::Timer& timer,
+            double time_budget = -1)
+    {
+        PricingContext context;
+        context.remaining_time = timer.remaining_time();
+        double budget = context.remaining_time;
+        if (time_budget >= 0)
+            budget = (std::min)(budget, time_budget);
+        if (budget < 1e9) {
+            context.deadline = std::chrono::steady_clock::now()
+                + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double>(budget));
+        }
+        return context;
+    }
+
+    /** Remaining time until 'deadline', in seconds. */
+    double remaining_budget() const
+    {
+        if (deadline == std::chrono::steady_clock::time_point::max())
+            return std::numeric_limits<double>::infinity();
+        std::chrono::duration<double> remaining = deadline - std::chrono::steady_clock::now();
+        return (std::max)(0.0, remaining.count());
+    }
+
+    /** Whether the call should end now. */
+    bool needs_to_end() const
+    {
+        if (cancel != nullptr && cancel->load(std::memory_order_relaxed))
+            return true;
+        return deadline != std::chrono::steady_clock::time_point::max()
+            && std::chrono::steady_clock::now() >= deadline;
+    }
+};
+
 /**
  * Interface for the pricing problem solver.
  */
@@ -273,13 +370,62 @@ public:
          * as overcost = N * rc* reflects them for the dual bound.
          */
         std::vector<Value> lagrangian_column_values;
+
+        /**
+         * Multiplicity of each column of 'columns' in the solution of the
+         * Lagrangian subproblem, e.g. N for the column of N identical
+         * subproblems, so that 'lagrangian_column_values' is the sum of the
+         * columns weighted by their multiplicities.
+         *
+         * Leave empty for a multiplicity of 1 for each column. If
+         * 'lagrangian_column_values' is set but not this, the solution of
+         * the Lagrangian subproblem isn't known column by column, and
+         * 'lagrangian_relaxation' doesn't return a primal solution.
+         */
+        std::vector<Value> lagrangian_column_multiplicities;
+
+        /**
+         * 'true' iff the search stopped early because of the
+         * 'PricingContext', so that not finding any column doesn't mean
+         * that there is none. 'overcost' must still follow its contract.
+         */
+        bool interrupted = false;
     };
 
+    /**
+     * Initialize the pricing subproblem for the given fixed columns, active
+     * cuts and branching decisions. Return the already known columns
+     * (static or previously generated) that are infeasible for them: these
+     * are kept out of the master LP, including when they come back from
+     * the column pool.
+     */
     virtual std::vector<std::shared_ptr<const Column>> initialize_pricing(
             const std::vector<std::pair<std::shared_ptr<const Column>, Value>>& fixed_columns,
             const std::vector<std::shared_ptr<const Cut>>& cuts,
             const std::vector<std::shared_ptr<const BranchingDecision>>& branching_decisions) = 0;
 
+    /**
+     * Same as above, also given the reduced cost fixing gap. This is the
+     * version called by the algorithms; by default, it ignores the gap.
+     *
+     * 'reduced_cost_fixing_gap' is the gap between the best known solution
+     * and the dual bound of the node being solved (infinity when there is
+     * no incumbent). A column whose reduced cost at the converged duals of
+     * the node exceeds it can't be part of a solution strictly better than
+     * the incumbent, so a pricing solver may override this to shrink its
+     * subproblem (e.g. eliminate arcs that only appear in such columns).
+     * Ignoring it is always correct.
+     */
+    virtual std::vector<std::shared_ptr<const Column>> initialize_pricing(
+            const std::vector<std::pair<std::shared_ptr<const Column>, Value>>& fixed_columns,
+            const std::vector<std::shared_ptr<const Cut>>& cuts,
+            const std::vector<std::shared_ptr<const BranchingDecision>>& branching_decisions,
+            Value reduced_cost_fixing_gap)
+    {
+        (void)reduced_cost_fixing_gap;
+        return initialize_pricing(fixed_columns, cuts, branching_decisions);
+    }
+
     /**
      * Number of pricing levels this solver supports (>= 1), e.g. a fast
      * heuristic (level 0), a more expensive heuristic, an exact algorithm,
@@ -295,6 +441,17 @@ public:
         return 1;
     }
 
+    /**
+     * Return 'true' iff 'solve_pricing' may be called concurrently, from
+     * different threads, for different pricing levels, between two calls
+     * to 'initialize_pricing' (see
+     * 'ColumnGenerationParameters::concurrent_pricing_levels').
+     */
+    virtual bool supports_concurrent_pricing_levels() const
+    {
+        return false;
+    }
+
     /**
      * Solve the pricing subproblem.
      *
@@ -309,12 +466,58 @@ public:
      * 'pricing_level' (see 'number_of_pricing_levels') selects how
      * thorough the search should be, independently of 'solve_feasibility'
      * -- both phases escalate through the same levels together.
+     *
+     * 'context' gives the time budget of the call and its cancellation
+     * flag (see 'PricingContext').
      */
     virtual PricingOutput solve_pricing(
             bool solve_feasibility,
             const std::vector<Value>& duals,
             const std::vector<std::pair<std::shared_ptr<const Cut>, Value>>& cut_duals,
-            Counter pricing_level) = 0;
+            Counter pricing_level,
+            const PricingContext& context) = 0;
+
+    /**
+     * Start a new subproblem generation (see
+     * 'PricingContext::subproblem_generation').
+     *
+     * Called by the algorithms of the library along with each call to
+     * 'initialize_pricing'.
+     */
+    void start_subproblem_generation()
+    {
+        subproblem_generation_++;
+        previous_duals_.clear();
+    }
+
+    /**
+     * Set the 'subproblem_generation' and the 'changed_rows' of 'context'
+     * for a call to 'solve_pricing' at 'duals', and record the call.
+     *
+     * Called by the algorithms of the library before each call to
+     * 'solve_pricing'.
+     */
+    void update_pricing_context(
+            bool solve_feasibility,
+            const std::vector<Value>& duals,
+            PricingContext& context)
+    {
+        if (!previous_duals_.empty()
+                && solve_feasibility != previous_solve_feasibility_) {
+            start_subproblem_generation();
+        }
+        context.subproblem_generation = subproblem_generation_;
+        context.changed_rows.clear();
+        context.has_changed_rows = !previous_duals_.empty()
+            && previous_duals_.size() == duals.size();
+        if (context.has_changed_rows) {
+            for (RowIdx row_id = 0; row_id < (RowIdx)duals.size(); ++row_id)
+                if (duals[row_id] != previous_duals_[row_id])
+                    context.changed_rows.push_back(row_id);
+        }
+        previous_duals_ = duals;
+        previous_solve_feasibility_ = solve_feasibility;
+    }
 
     /**
      * Separate cutting planes from the current relaxation solution.
@@ -429,6 +632,20 @@ public:
         (void)solution;
         return {};
     }
+
+private:
+
+    /** Current subproblem generation. */
+    Counter subproblem_generation_ = 0;
+
+    /**
+     * Duals of the previous call to 'solve_pricing' of the current
+     * generation (empty if none).
+     */
+    std::vector<Value> previous_duals_;
+
+    /** 'solve_feasibility' of the previous call to 'solve_pricing'. */
+    bool previous_solve_feasibility_ = false;
 };
 
 /**
@@ -458,6 +675,26 @@ struct Model
     /** Column which are not dynamically generated. */
     std::vector<std::shared_ptr<const Column>> static_columns;
 
+    /**
+     * Dual-optimal inequalities, given as columns: the dual constraint of
+     * such a column (e.g. 'Σ a π <= c' for a minimization problem with
+     * covering rows) must be satisfied by at least one optimal dual
+     * solution of the linear relaxation. Typical example: for cutting
+     * stock, the dual value of an item type is at least the one of any
+     * smaller item type, i.e. a column of cost 0 with coefficient +1 on
+     * the row of the smaller one and -1 on the row of the larger one.
+     *
+     * They are only added to the master LP of the optimality phase (see
+     * 'ColumnGenerationParameters::dual_optimal_inequalities'), where they
+     * cut off dual solutions and so reduce degeneracy. They are never
+     * part of a solution, nor of the bound, which only involve the real
+     * columns: if the LP solution still uses some of them at convergence,
+     * they are removed and the column generation goes on, so that the
+     * relaxation solution returned is always one of the original master.
+     * 'lower_bound' is ignored (always 0); cut coefficients are 0.
+     */
+    std::vector<std::shared_ptr<const Column>> dual_optimal_inequalities;
+
 
     void check_column(
             const std::shared_ptr<const Column>& column) const
@@ -503,6 +740,7 @@ struct Model
                 << "Objective sense:           " << ((objective_sense == optimizationtools::ObjectiveDirection::Minimize)? "Minimize": "Maximize") << std::endl
                 << "Number of constraints:     " << rows.size() << std::endl
                 << "Number of static columns:  " << static_columns.size() << std::endl
+                << "Number of DOIs:            " << dual_optimal_inequalities.size() << std::endl
                 ;
         }
 
@@ -953,6 +1191,17 @@ private:
 
 };
 
+/**
+ * Approximate memory used by a solution, not counting its columns, which
+ * are shared.
+ */
+inline Counter memory(const Solution& solution)
+{
+    return sizeof(Solution)
+        + solution.model().rows.size() * sizeof(Value)
+        + solution.columns().capacity() * sizeof(std::pair<std::shared_ptr<const Column>, Value>);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////// Implementation ////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -1028,10 +1277,143 @@ struct ColumnHasher
     }
 };
 
+/**
+ * Column pool shared by all the column generation calls of a search.
+ *
+ * Identical columns (see 'ColumnHasher') are only stored once, and each
+ * column gets a stable index when it is added, so that a search can pass
+ * the same pool to every node instead of copying and rehashing it. It is
+ * never filtered: each column generation call skips the columns
+ * infeasible for its own fixed columns lazily, while scanning it.
+ */
+class ColumnPool
+{
+
+public:
+
+    /** Constructor. */
+    ColumnPool(const Model& model):
+        column_hasher_(model),
+        column_ids_(0, column_hasher_, column_hasher_) { }
+
+    /** Constructor. */
+    ColumnPool(
+            const Model& model,
+            const std::vector<std::shared_ptr<const Column>>& columns):
+        ColumnPool(model)
+    {
+        for (const auto& column: columns)
+            add(column);
+    }
+
+    ColumnPool(const ColumnPool&) = delete;
+    ColumnPool& operator=(const ColumnPool&) = delete;
+
+    /**
+     * Add a column to the pool.
+     *
+     * Return the index of the column, and 'false' if an identical column
+     * was already in the pool (in which case the returned index is the
+     * one of that column).
+     */
+    std::pair<ColIdx, bool> add(const std::shared_ptr<const Column>& column)
+    {
+        auto res = column_ids_.insert({column, (ColIdx)columns_.size()});
+        if (res.second) {
+            columns_.push_back(column);
+            memory_ += columngenerationsolver::memory(*column)
+                // Node of 'column_ids_' and entry of 'columns_'.
+                + sizeof(std::pair<const std::shared_ptr<const Column>, ColIdx>) + 2 * sizeof(void*)
+                + sizeof(std::shared_ptr<const Column>);
+        }
+        return {res.first->second, res.second};
+    }
+
+    /** Return 'true' iff the pool contains a column identical to 'column'. */
+    bool contains(const std::shared_ptr<const Column>& column) const
+    {
+        return column_ids_.find(column) != column_ids_.end();
+    }
+
+    /** Get the number of columns in the pool. */
+    ColIdx number_of_columns() const { return columns_.size(); }
+
+    /** Get a column. */
+    const std::shared_ptr<const Column>& column(ColIdx column_id) const { return columns_[column_id]; }
+
+    /** Get the columns, in the order they were added. */
+    const std::vector<std::shared_ptr<const Column>>& columns() const { return columns_; }
+
+    /** Get the approximate memory used by the pool and its columns, in bytes. */
+    Counter memory() const { return memory_; }
+
+private:
+
+    /** Hasher. */
+    ColumnHasher column_hasher_;
+
+    /** Map from a column to its index. */
+    std::unordered_map<
+        std::shared_ptr<const Column>,
+        ColIdx,
+        const ColumnHasher&,
+        const ColumnHasher&> column_ids_;
+
+    /** Columns. */
+    std::vector<std::shared_ptr<const Column>> columns_;
+
+    /** Approximate memory used, in bytes. */
+    Counter memory_ = 0;
+
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * Peak resident set size of the process, in bytes.
+ *
+ * Only available on Linux; return -1 on other platforms.
+ */
+Counter peak_resident_set_size();
+
+/**
+ * Approximate memory, in bytes, held by the main data structures of an
+ * algorithm.
+ */
+struct MemoryUsage
+{
+    /** Column pool, including its columns. */
+    Counter column_pool = 0;
+
+    /**
+     * 'Output::columns'. The columns themselves are counted in
+     * 'column_pool'.
+     */
+    Counter columns = 0;
+
+    /** Open nodes of a tree search, and the relaxation solutions they keep. */
+    Counter open_nodes = 0;
+
+    /** Master LP. */
+    Counter master_lp = 0;
+
+
+    /** Get the total. */
+    Counter total() const { return column_pool + columns + open_nodes + master_lp; }
+
+    nlohmann::json to_json() const
+    {
+        return {
+            {"ColumnPool", column_pool},
+            {"Columns", columns},
+            {"OpenNodes", open_nodes},
+            {"MasterLp", master_lp},
+        };
+    }
+};
+
 struct Output: optimizationtools::Output
 {
     /** Constructor. */
@@ -1067,6 +1449,68 @@ struct Output: optimizationtools::Output
      */
     double time_rounding_heuristic = 0.0;
 
+    /**
+     * Time spent building the master LPs: creating the linear programming
+     * solver and adding the static, initial, dummy and stabilization
+     * columns. Doesn't include the initialization of the pricing solver.
+     */
+    double time_master_construction = 0.0;
+
+    /** Time spent looking for columns with a negative reduced cost in the column pool. */
+    double time_column_pool_scan = 0.0;
+
+    /**
+     * Time spent computing the coefficients of the columns in the cuts.
+     * Included in 'time_master_construction' for the columns added when
+     * building a master LP.
+     */
+    double time_cut_coefficients = 0.0;
+
+    /** Time spent separating cuts. */
+    double time_cut_separation = 0.0;
+
+    /**
+     * Time spent computing the stabilized duals, the subgradient and the
+     * smoothing parameter.
+     */
+    double time_stabilization = 0.0;
+
+    /** Time spent building the relaxation solutions. */
+    double time_solution_building = 0.0;
+
+    /** Number of master LPs built from scratch (not reused). */
+    Counter number_of_lp_rebuilds = 0;
+
+    /**
+     * Number of columns added to the master LPs (static, initial and
+     * generated ones, not the artificial ones).
+     */
+    Counter number_of_columns_added = 0;
+
+    /**
+     * Number of columns removed from a reused master LP, i.e. disabled
+     * through bounds [0, 0] because they have become infeasible.
+     */
+    Counter number_of_columns_removed = 0;
+
+    /** Maximum number of columns in the column pool. */
+    ColIdx maximum_column_pool_size = 0;
+
+    /** Current approximate memory usage. */
+    MemoryUsage memory_usage;
+
+    /** Peak of each field of 'memory_usage'. */
+    MemoryUsage peak_memory_usage;
+
+    /** Peak of the total of 'memory_usage'. */
+    Counter peak_total_memory_usage = 0;
+
+    /**
+     * Peak resident set size of the process, in bytes, -1 if not
+     * available (see 'columngenerationsolver::peak_resident_set_size').
+     */
+    Counter peak_resident_set_size = -1;
+
     /** Number of column generation iterations. */
     Counter number_of_column_generation_iterations = 0;
 
@@ -1077,6 +1521,49 @@ struct Output: optimizationtools::Output
     Solution relaxation_solution;
 
 
+    /**
+     * Add the timings and counters of the master of 'output', the output
+     * of a column generation or Lagrangian relaxation run by this
+     * algorithm.
+     */
+    void add_master_statistics(const Output& output)
+    {
+        time_master_construction += output.time_master_construction;
+        time_column_pool_scan += output.time_column_pool_scan;
+        time_cut_coefficients += output.time_cut_coefficients;
+        time_cut_separation += output.time_cut_separation;
+        time_stabilization += output.time_stabilization;
+        time_solution_building += output.time_solution_building;
+        number_of_lp_rebuilds += output.number_of_lp_rebuilds;
+        number_of_columns_added += output.number_of_columns_added;
+        number_of_columns_removed += output.number_of_columns_removed;
+        maximum_column_pool_size = (std::max)(
+                maximum_column_pool_size,
+                output.maximum_column_pool_size);
+        update_peak_memory_usage(output.peak_memory_usage);
+        peak_total_memory_usage = (std::max)(
+                peak_total_memory_usage,
+                output.peak_total_memory_usage);
+    }
+
+    /** Update the peaks of the memory usage with 'memory_usage'. */
+    void update_peak_memory_usage()
+    {
+        update_peak_memory_usage(memory_usage);
+        peak_total_memory_usage = (std::max)(
+                peak_total_memory_usage,
+                memory_usage.total());
+    }
+
+    /** Update the peak of each field of the memory usage with 'usage'. */
+    void update_peak_memory_usage(const MemoryUsage& usage)
+    {
+        peak_memory_usage.column_pool = (std::max)(peak_memory_usage.column_pool, usage.column_pool);
+        peak_memory_usage.columns = (std::max)(peak_memory_usage.columns, usage.columns);
+        peak_memory_usage.open_nodes = (std::max)(peak_memory_usage.open_nodes, usage.open_nodes);
+        peak_memory_usage.master_lp = (std::max)(peak_memory_usage.master_lp, usage.master_lp);
+    }
+
     std::string solution_value() const
     {
         return optimizationtools::solution_value(
@@ -1166,6 +1653,21 @@ struct Output: optimizationtools::Output
             {"PricingTime", time_pricing},
             {"LpTime", time_lpsolve},
             {"RoundingHeuristicTime", time_rounding_heuristic},
+            {"MasterConstructionTime", time_master_construction},
+            {"ColumnPoolScanTime", time_column_pool_scan},
+            {"CutCoefficientsTime", time_cut_coefficients},
+            {"CutSeparationTime", time_cut_separation},
+            {"StabilizationTime", time_stabilization},
+            {"SolutionBuildingTime", time_solution_building},
+            {"NumberOfLpRebuilds", number_of_lp_rebuilds},
+            {"NumberOfColumnsAdded", number_of_columns_added},
+            {"NumberOfColumnsRemoved", number_of_columns_removed},
+            {"MaximumColumnPoolSize", maximum_column_pool_size},
+            {"MemoryUsage", memory_usage.to_json()},
+            {"TotalMemoryUsage", memory_usage.total()},
+            {"PeakMemoryUsage", peak_memory_usage.to_json()},
+            {"PeakTotalMemoryUsage", peak_total_memory_usage},
+            {"PeakResidentSetSize", peak_resident_set_size},
             {"NumberOfColumnGenerationIterations", number_of_column_generation_iterations},
         };
     }
@@ -1184,6 +1686,22 @@ struct Output: optimizationtools::Output
             << std::setw(width) << std::left << "Pricing time: " << time_pricing << std::endl
             << std::setw(width) << std::left << "Linear programming time: " << time_lpsolve << std::endl
             << std::setw(width) << std::left << "Rounding heuristic time: " << time_rounding_heuristic << std::endl
+            << std::setw(width) << std::left << "Master construction time: " << time_master_construction << std::endl
+            << std::setw(width) << std::left << "Column pool scan time: " << time_column_pool_scan << std::endl
+            << std::setw(width) << std::left << "Cut coefficients time: " << time_cut_coefficients << std::endl
+            << std::setw(width) << std::left << "Cut separation time: " << time_cut_separation << std::endl
+            << std::setw(width) << std::left << "Stabilization time: " << time_stabilization << std::endl
+            << std::setw(width) << std::left << "Solution building time: " << time_solution_building << std::endl
+            << std::setw(width) << std::left << "Number of LP rebuilds: " << number_of_lp_rebuilds << std::endl
+            << std::setw(width) << std::left << "Number of columns added: " << number_of_columns_added << std::endl
+            << std::setw(width) << std::left << "Number of columns removed: " << number_of_columns_removed << std::endl
+            << std::setw(width) << std::left << "Max. column pool size: " << maximum_column_pool_size << std::endl
+            << std::setw(width) << std::left << "Peak memory usage (MB): " << (double)peak_total_memory_usage / 1e6 << std::endl
+            << std::setw(width) << std::left << "    Column pool: " << (double)peak_memory_usage.column_pool / 1e6 << std::endl
+            << std::setw(width) << std::left << "    Columns: " << (double)peak_memory_usage.columns / 1e6 << std::endl
+            << std::setw(width) << std::left << "    Open nodes: " << (double)peak_memory_usage.open_nodes / 1e6 << std::endl
+            << std::setw(width) << std::left << "    Master LP: " << (double)peak_memory_usage.master_lp / 1e6 << std::endl
+            << std::setw(width) << std::left << "Peak RSS (MB): " << ((peak_resident_set_size == -1)? -1.0: (double)peak_resident_set_size / 1e6) << std::endl
             << std::setw(width) << std::left << "Number of CG iterations: " << number_of_column_generation_iterations << std::endl
             << std::setw(width) << std::left << "Number of new columns: " << columns.size() << std::endl
             ;
@@ -1258,6 +1776,8 @@ inline SolverName s2lps(const std::string& s)
     }
 }
 
+class EventStreamWriter;
+
 struct Parameters: optimizationtools::Parameters
 {
     /** Callback function called when a new best solution is found. */
@@ -1314,6 +1834,19 @@ struct Parameters: optimizationtools::Parameters
      */
     int rounding_heuristic = 0;
 
+    /**
+     * Interval, in seconds, between two prints of the memory usage (see
+     * 'Output::memory_usage'); -1: never.
+     */
+    double memory_usage_log_interval = 60;
+
+    /**
+     * Writer of the events of the algorithm ('nullptr': none), see
+     * 'EventStreamWriter'. Only the algorithm called gets it, not the
+     * column generations run by the tree search algorithms.
+     */
+    std::shared_ptr<EventStreamWriter> event_stream_writer = nullptr;
+
 
     virtual nlohmann::json to_json() const override
     {
@@ -1327,6 +1860,7 @@ struct Parameters: optimizationtools::Parameters
                 {"InternalDiving", internal_diving},
                 {"CuttingPlanes", cutting_planes},
                 {"RoundingHeuristic", rounding_heuristic},
+                {"MemoryUsageLogInterval", memory_usage_log_interval},
                 });
         return json;
     }
@@ -1346,6 +1880,7 @@ struct Parameters: optimizationtools::Parameters
             << std::setw(width) << std::left << "Internal diving: " << internal_diving << std::endl
             << std::setw(width) << std::left << "Cutting planes: " << cutting_planes << std::endl
             << std::setw(width) << std::left << "Rounding heuristic: " << rounding_heuristic << std::endl
+            << std::setw(width) << std::left << "Memory usage log interval: " << memory_usage_log_interval << std::endl
             ;
     }
 };
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "columngenerationsolver/commons.hpp"
+
+#include <fstream>
+#include <functional>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+namespace columngenerationsolver
+{
+
+/**
+ * Writer of the events of an algorithm to a file, one JSON object per line,
+ * appended as they happen.
+ *
+ * Set it in 'Parameters::event_stream_writer'. The algorithm writes:
+ * - a "Start" event, with the name of the algorithm
+ * - a "NewSolution" event for each new best solution
+ * - a "NewBound" event for each new best bound
+ * - a "Node" event for each node processed by the tree search algorithms
+ * - an "End" event
+ *
+ * Unlike rewriting the JSON output on each new best solution, the cost of
+ * an event doesn't depend on the length of the run. The file is written
+ * through a large buffer, which is flushed when it is full, at most every
+ * 'flush_interval' seconds when an event is written, and at the "End"
+ * event.
+ */
+class EventStreamWriter
+{
+
+public:
+
+    /** Constructor. */
+    EventStreamWriter(
+            const std::string& path,
+            double flush_interval = 1.0);
+
+    /** Write an event; 'event' gets an "Event" field set to 'name'. */
+    void write(
+            const std::string& name,
+            nlohmann::json event);
+
+    /** Flush the file. */
+    void flush();
+
+private:
+
+    /** Buffer of the file. */
+    std::vector<char> buffer_;
+
+    /** Output file. */
+    std::ofstream file_;
+
+    /** Minimum time between two flushes triggered by an event. */
+    double flush_interval_;
+
+    /** Time of the last flush. */
+    std::chrono::steady_clock::time_point last_flush_time_;
+
+    /** Mutex protecting 'file_'. */
+    std::mutex mutex_;
+
+};
+
+/**
+ * Writer running write functions, e.g. writing the certificate of a new
+ * best solution, on a background thread, so that the algorithm doesn't
+ * wait for them.
+ *
+ * Only the latest write submitted is pending at any time: a write
+ * submitted while another one is pending replaces it, since the file it
+ * would write is going to be overwritten anyway. The destructor waits for
+ * the pending write.
+ */
+class BackgroundWriter
+{
+
+public:
+
+    /** Constructor. */
+    BackgroundWriter();
+
+    /** Destructor. */
+    ~BackgroundWriter();
+
+    /** Submit a write. */
+    void submit(std::function<void()> write);
+
+    /**
+     * Wait until there is no pending or running write, and rethrow the
+     * exception thrown by a write since the last call, if any.
+     */
+    void wait();
+
+    /** Get the number of writes replaced before they were run. */
+    Counter number_of_skipped_writes() const { return number_of_skipped_writes_; }
+
+private:
+
+    /** Body of the background thread. */
+    void run();
+
+    /** Pending write. */
+    std::function<void()> pending_write_;
+
+    /** 'true' iff a write is running. */
+    bool running_ = false;
+
+    /** 'true' iff the background thread must stop. */
+    bool stop_ = false;
+
+    /** Number of writes replaced before they were run. */
+    Counter number_of_skipped_writes_ = 0;
+
+    /** Exception thrown by a write. */
+    std::exception_ptr exception_ = nullptr;
+
+    /** Mutex protecting the attributes above. */
+    std::mutex mutex_;
+
+    /** Condition variable signaling a new write or the stop. */
+    std::condition_variable write_submitted_;
+
+    /** Condition variable signaling the end of a write. */
+    std::condition_variable write_done_;
+
+    /** Background thread. */
+    std::thread thread_;
+
+};
+
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "columngenerationsolver/commons.hpp"
+
+#include <fstream>
+#include <mutex>
+
+namespace columngenerationsolver
+{
+
+/**
+ * Statistics of a single column generation iteration, written by an
+ * 'IterationTraceWriter'.
+ *
+ * Times are the ones of the iteration only, not cumulated.
+ */
+struct ColumnGenerationIterationRecord
+{
+    /**
+     * Id of the node of the tree search the column generation is run for
+     * (see 'ColumnGenerationParameters::node_id'), -1 if none.
+     */
+    Counter node_id = -1;
+
+    /** Cutting-plane round. */
+    Counter cutting_plane_iteration = 0;
+
+    /** 'true' in the feasibility phase, 'false' in the optimality phase. */
+    bool solve_feasibility = false;
+
+    /** Iteration within the phase. */
+    Counter iteration = 0;
+
+    /** Elapsed time of the algorithm. */
+    double time = 0.0;
+
+    /** Time spent solving the master LP. */
+    double time_lpsolve = 0.0;
+
+    /** Time spent scanning the column pool. */
+    double time_column_pool_scan = 0.0;
+
+    /** Time spent in the pricing solver. */
+    double time_pricing = 0.0;
+
+    /** Number of improving columns found in the column pool. */
+    Counter number_of_column_pool_hits = 0;
+
+    /** Number of columns returned by the pricing solver. */
+    Counter number_of_priced_columns = 0;
+
+    /**
+     * Number of columns with a negative reduced cost found, in the column
+     * pool or by the pricing solver (before 'ColumnGenerationParameters::
+     * maximum_number_of_columns_per_iteration' applies).
+     */
+    Counter number_of_improving_columns = 0;
+
+    /** Number of mispricings. */
+    Counter number_of_mispricings = 0;
+
+    /**
+     * Wentges smoothing parameter of the last pricing call (NaN if the
+     * pricing solver hasn't been called).
+     */
+    double alpha = std::numeric_limits<double>::quiet_NaN();
+
+    /**
+     * Directional smoothing parameter of the last pricing call (NaN if the
+     * pricing solver hasn't been called).
+     */
+    double beta = std::numeric_limits<double>::quiet_NaN();
+
+    /** Euclidean norm of the duals of the master LP. */
+    Value dual_norm = 0.0;
+
+    /** Number of columns in the master LP. */
+    ColIdx number_of_columns_in_linear_subproblem = 0;
+
+    /** Value of the master LP. */
+    Value relaxation_solution_value = 0.0;
+
+    /** Bound. */
+    Value bound = 0.0;
+};
+
+enum class IterationTraceFormat
+{
+    /** One JSON object per line. */
+    Ndjson,
+
+    /** Comma-separated values, with a header line. */
+    Csv,
+};
+
+inline std::istream& operator>>(
+        std::istream& in,
+        IterationTraceFormat& format)
+{
+    std::string token;
+    in >> token;
+    if (token == "ndjson" || token == "NDJSON") {
+        format = IterationTraceFormat::Ndjson;
+    } else if (token == "csv" || token == "CSV") {
+        format = IterationTraceFormat::Csv;
+    } else {
+        in.setstate(std::ios_base::failbit);
+    }
+    return in;
+}
+
+/**
+ * Writer of the per-iteration statistics of column generation to a file.
+ *
+ * Set it in 'ColumnGenerationParameters::iteration_trace_writer'. Since the
+ * tree search algorithms copy their 'column_generation_parameters' for
+ * each node, a single writer receives the iterations of all the nodes, and
+ * it can be shared between threads.
+ */
+class IterationTraceWriter
+{
+
+public:
+
+    /** Constructor. */
+    IterationTraceWriter(
+            const std::string& path,
+            IterationTraceFormat format = IterationTraceFormat::Ndjson);
+
+    /** Write a record. */
+    void write(const ColumnGenerationIterationRecord& record);
+
+private:
+
+    /** Format. */
+    IterationTraceFormat format_;
+
+    /** Output file. */
+    std::ofstream file_;
+
+    /** Mutex protecting 'file_'. */
+    std::mutex mutex_;
+
+};
+
+}
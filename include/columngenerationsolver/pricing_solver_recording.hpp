@@ -0,0 +1,258 @@
+#pragma once
+
+#include "columngenerationsolver/commons.hpp"
+
+#include <fstream>
+#include <mutex>
+
+namespace columngenerationsolver
+{
+
+/**
+ * Hash of the input of a call to 'PricingSolver::solve_pricing':
+ * 'solve_feasibility', 'duals', the values of 'cut_duals' and
+ * 'pricing_level'.
+ *
+ * It only depends on the bits of the values, so that it is the same from
+ * one run to the next and from one platform to the other.
+ */
+uint64_t pricing_input_hash(
+        bool solve_feasibility,
+        const std::vector<Value>& duals,
+        const std::vector<std::pair<std::shared_ptr<const Cut>, Value>>& cut_duals,
+        Counter pricing_level);
+
+/**
+ * Pricing solver recording the calls to another pricing solver.
+ *
+ * Every call is forwarded to the wrapped pricing solver. The columns
+ * returned by 'initialize_pricing' and the inputs (as a
+ * 'pricing_input_hash') and outputs of 'solve_pricing' are written to a
+ * file, one JSON object per line, which a 'ReplayPricingSolver' can serve
+ * back.
+ *
+ * The 'extra' field of the columns is not recorded.
+ */
+class RecordingPricingSolver: public PricingSolver
+{
+
+public:
+
+    /** Constructor. */
+    RecordingPricingSolver(
+            std::unique_ptr<PricingSolver> pricing_solver,
+            const std::string& path);
+
+    virtual std::vector<std::shared_ptr<const Column>> initialize_pricing(
+            const std::vector<std::pair<std::shared_ptr<const Column>, Value>>& fixed_columns,
+            const std::vector<std::shared_ptr<const Cut>>& cuts,
+            const std::vector<std::shared_ptr<const BranchingDecision>>& branching_decisions) override
+    {
+        return initialize_pricing(
+                fixed_columns,
+                cuts,
+                branching_decisions,
+                std::numeric_limits<Value>::infinity());
+    }
+
+    virtual std::vector<std::shared_ptr<const Column>> initialize_pricing(
+            const std::vector<std::pair<std::shared_ptr<const Column>, Value>>& fixed_columns,
+            const std::vector<std::shared_ptr<const Cut>>& cuts,
+            const std::vector<std::shared_ptr<const BranchingDecision>>& branching_decisions,
+            Value reduced_cost_fixing_gap) override;
+
+    virtual Counter number_of_pricing_levels() const override
+    {
+        return pricing_solver_->number_of_pricing_levels();
+    }
+
+    virtual bool supports_concurrent_pricing_levels() const override
+    {
+        return pricing_solver_->supports_concurrent_pricing_levels();
+    }
+
+    virtual PricingOutput solve_pricing(
+            bool solve_feasibility,
+            const std::vector<Value>& duals,
+            const std::vector<std::pair<std::shared_ptr<const Cut>, Value>>& cut_duals,
+            Counter pricing_level,
+            const PricingContext& context) override;
+
+    virtual std::vector<std::shared_ptr<const Cut>> separate_cuts(
+            const Solution& solution) override
+    {
+        return pricing_solver_->separate_cuts(solution);
+    }
+
+    virtual Value coefficient(
+            const Cut& cut,
+            const Column& column) const override
+    {
+        return pricing_solver_->coefficient(cut, column);
+    }
+
+    virtual bool equal(
+            const Cut& cut_1,
+            const Cut& cut_2) const override
+    {
+        return pricing_solver_->equal(cut_1, cut_2);
+    }
+
+    virtual std::vector<BranchingCandidate> compute_branching_candidates(
+            const Solution& solution) override
+    {
+        return pricing_solver_->compute_branching_candidates(solution);
+    }
+
+    /** Get the wrapped pricing solver. */
+    PricingSolver& pricing_solver() const { return *pricing_solver_; }
+
+private:
+
+    /**
+     * Return the JSON representation of a list of columns: the id of each
+     * column, and 'new_columns' gets the description of the ones which
+     * haven't been written yet.
+     */
+    nlohmann::json column_ids(
+            const std::vector<std::shared_ptr<const Column>>& columns,
+            nlohmann::json& new_columns);
+
+    /** Wrapped pricing solver. */
+    std::unique_ptr<PricingSolver> pricing_solver_;
+
+    /** Output file. */
+    std::ofstream file_;
+
+    /**
+     * Ids of the columns already written. The columns are kept alive so
+     * that their addresses are not reused.
+     */
+    std::unordered_map<std::shared_ptr<const Column>, Counter> column_ids_;
+
+    /** Mutex protecting 'file_' and 'column_ids_'. */
+    std::mutex mutex_;
+
+};
+
+/**
+ * Pricing solver serving back the calls recorded by a
+ * 'RecordingPricingSolver', without running the original pricing solver.
+ *
+ * Meant to benchmark the master (linear programming solvers,
+ * stabilization, column pool strategies...) deterministically. Each call to
+ * 'initialize_pricing' moves to the next recorded one. Each call to
+ * 'solve_pricing' serves the recorded call of the current subproblem with
+ * the same input hash if there is one; otherwise, the next recorded call
+ * not served yet, which is counted as a mismatch: if the master behaves
+ * differently from the recorded run, the duals differ, and the outputs
+ * served, in particular 'overcost', are only a realistic workload, not
+ * valid pricing results. Once all the recorded calls of the current
+ * subproblem have been served, no column is returned.
+ *
+ * The columns served are the same objects each time, but without their
+ * 'extra' field, so the solutions can't be converted back into solutions
+ * of the original problem. Cuts and branching are not supported.
+ */
+class ReplayPricingSolver: public PricingSolver
+{
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * If 'strict' is 'true', a mismatch throws an exception.
+     */
+    ReplayPricingSolver(
+            const std::string& path,
+            bool strict = false);
+
+    virtual std::vector<std::shared_ptr<const Column>> initialize_pricing(
+            const std::vector<std::pair<std::shared_ptr<const Column>, Value>>& fixed_columns,
+            const std::vector<std::shared_ptr<const Cut>>& cuts,
+            const std::vector<std::shared_ptr<const BranchingDecision>>& branching_decisions) override
+    {
+        return initialize_pricing(
+                fixed_columns,
+                cuts,
+                branching_decisions,
+                std::numeric_limits<Value>::infinity());
+    }
+
+    virtual std::vector<std::shared_ptr<const Column>> initialize_pricing(
+            const std::vector<std::pair<std::shared_ptr<const Column>, Value>>& fixed_columns,
+            const std::vector<std::shared_ptr<const Cut>>& cuts,
+            const std::vector<std::shared_ptr<const BranchingDecision>>& branching_decisions,
+            Value reduced_cost_fixing_gap) override;
+
+    virtual Counter number_of_pricing_levels() const override
+    {
+        return number_of_pricing_levels_;
+    }
+
+    virtual PricingOutput solve_pricing(
+            bool solve_feasibility,
+            const std::vector<Value>& duals,
+            const std::vector<std::pair<std::shared_ptr<const Cut>, Value>>& cut_duals,
+            Counter pricing_level,
+            const PricingContext& context) override;
+
+    /** Get the number of calls to 'solve_pricing' served. */
+    Counter number_of_calls() const { return number_of_calls_; }
+
+    /** Get the number of calls to 'solve_pricing' with no matching input. */
+    Counter number_of_mismatches() const { return number_of_mismatches_; }
+
+private:
+
+    /** Recorded call to 'solve_pricing'. */
+    struct RecordedPricing
+    {
+        /** Input hash. */
+        uint64_t input_hash;
+
+        /** Output. */
+        PricingOutput output;
+
+        /** 'true' iff it has already been served. */
+        bool served = false;
+    };
+
+    /** Recorded call to 'initialize_pricing' and the following pricings. */
+    struct RecordedSubproblem
+    {
+        /** Columns returned by 'initialize_pricing'. */
+        std::vector<std::shared_ptr<const Column>> infeasible_columns;
+
+        /** Calls to 'solve_pricing'. */
+        std::vector<RecordedPricing> pricings;
+    };
+
+    /** Path of the recording. */
+    std::string path_;
+
+    /** Throw on mismatch. */
+    bool strict_;
+
+    /** Number of pricing levels of the recorded pricing solver. */
+    Counter number_of_pricing_levels_ = 1;
+
+    /** Recorded subproblems. */
+    std::vector<RecordedSubproblem> subproblems_;
+
+    /** Current subproblem, -1 before the first call to 'initialize_pricing'. */
+    Counter subproblem_pos_ = -1;
+
+    /** Position of the next recorded pricing to serve in case of mismatch. */
+    Counter next_pricing_pos_ = 0;
+
+    /** Number of calls to 'solve_pricing' served. */
+    Counter number_of_calls_ = 0;
+
+    /** Number of calls to 'solve_pricing' with no matching input. */
+    Counter number_of_mismatches_ = 0;
+
+};
+
+}
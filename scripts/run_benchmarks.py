@@ -0,0 +1,264 @@
+# /// script
+# requires-python = ">=3.12"
+# dependencies = []
+# ///
+
+"""Performance regression runner.
+
+Run each instance of the tests of 'run_tests.py' several times, collect the
+timings, iteration counts and peak memory of each run, and compare them to
+the ones of a baseline directory created the same way with another build:
+
+    python3 scripts/run_benchmarks.py benchmark_results_ref
+    # ... switch to the new build ...
+    python3 scripts/run_benchmarks.py benchmark_results --baseline benchmark_results_ref
+
+A metric is reported as a regression when its increase is statistically
+significant (two-sided Mann-Whitney U test) and larger than a minimum
+relative change. Nothing is downloaded: the data directories are the ones
+of 'run_tests.py'.
+"""
+
+import argparse
+import itertools
+import json
+import math
+import os
+import shlex
+import statistics
+import subprocess
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import run_tests
+
+
+SUMMARY_FILE_NAME = "benchmark_results.json"
+
+# Metrics read from the JSON outputs.
+JSON_METRICS = [
+        "Time",
+        "PricingTime",
+        "LpTime",
+        "NumberOfColumnGenerationIterations",
+        "NumberOfNodes",
+        "PeakTotalMemoryUsage",
+]
+
+# Metric measured by this script.
+PEAK_RSS_METRIC = "PeakRss"
+
+
+def find_metric(json_output, key):
+    """Return the value of 'key' in a JSON output, wherever it is nested,
+    or None."""
+    if isinstance(json_output, dict):
+        if key in json_output and isinstance(json_output[key], (int, float)):
+            return json_output[key]
+        for value in json_output.values():
+            res = find_metric(value, key)
+            if res is not None:
+                return res
+    return None
+
+
+def run_command(command):
+    """Run a command, return its exit status and its peak resident set
+    size in bytes (None if it can't be measured on this platform)."""
+    process = subprocess.Popen(
+            shlex.split(command),
+            stdout=subprocess.DEVNULL)
+    if hasattr(os, "wait4"):
+        _, status, rusage = os.wait4(process.pid, 0)
+        process.returncode = os.waitstatus_to_exitcode(status)
+        # ru_maxrss is in kilobytes on Linux, in bytes on macOS.
+        peak_rss = rusage.ru_maxrss
+        if sys.platform != "darwin":
+            peak_rss *= 1024
+        return process.returncode, peak_rss
+    return process.wait(), None
+
+
+def run(args):
+    results = {}
+    for test_name in run_tests.TESTS:
+        if args.tests is not None and test_name not in args.tests:
+            continue
+        test_results = results.setdefault(test_name, {})
+        for repetition in range(args.repetitions):
+            instances = run_tests.test_instances(
+                    test_name,
+                    args.directory,
+                    suffix="_" + str(repetition) + ".json",
+                    verbosity_level=0)
+            for instance, command, json_output_path in instances:
+                print(command)
+                status, peak_rss = run_command(command)
+                if status != 0:
+                    sys.exit(1)
+                with open(json_output_path) as json_file:
+                    json_output = json.load(json_file)
+                instance_results = test_results.setdefault(instance, {})
+                for metric in JSON_METRICS:
+                    value = find_metric(json_output, metric)
+                    if value is not None:
+                        instance_results.setdefault(metric, []).append(value)
+                if peak_rss is not None:
+                    instance_results.setdefault(PEAK_RSS_METRIC, []).append(peak_rss)
+
+    summary = {
+            "Repetitions": args.repetitions,
+            "Results": results,
+    }
+    with open(os.path.join(args.directory, SUMMARY_FILE_NAME), "w") as summary_file:
+        json.dump(summary, summary_file, indent=4)
+    return summary
+
+
+def mann_whitney_u_test(sample_1, sample_2):
+    """Two-sided p-value of the Mann-Whitney U test.
+
+    Exact (by enumeration of the rank assignments) for small samples,
+    normal approximation with tie correction otherwise."""
+    n_1 = len(sample_1)
+    n_2 = len(sample_2)
+    values = sorted(sample_1 + sample_2)
+    n = n_1 + n_2
+
+    # Mid-ranks.
+    ranks = {}
+    position = 0
+    while position < n:
+        position_end = position
+        while position_end + 1 < n and values[position_end + 1] == values[position]:
+            position_end += 1
+        ranks[values[position]] = (position + position_end) / 2 + 1
+        position = position_end + 1
+    all_ranks = [ranks[value] for value in values]
+
+    rank_sum_1 = sum(ranks[value] for value in sample_1)
+    u = rank_sum_1 - n_1 * (n_1 + 1) / 2
+    mean = n_1 * n_2 / 2
+    deviation = abs(u - mean)
+
+    if math.comb(n, n_1) <= 100000:
+        number_of_extreme = 0
+        number_of_assignments = 0
+        for positions in itertools.combinations(range(n), n_1):
+            u_perm = sum(all_ranks[p] for p in positions) - n_1 * (n_1 + 1) / 2
+            if abs(u_perm - mean) >= deviation - 1e-9:
+                number_of_extreme += 1
+            number_of_assignments += 1
+        return number_of_extreme / number_of_assignments
+
+    tie_correction = sum(
+            t ** 3 - t
+            for t in (all_ranks.count(r) for r in set(all_ranks)))
+    variance = n_1 * n_2 / 12 * ((n + 1) - tie_correction / (n * (n - 1)))
+    if variance == 0:
+        return 1.0
+    z = (deviation - 0.5) / math.sqrt(variance)
+    return math.erfc(max(z, 0) / math.sqrt(2))
+
+
+def compare(summary, baseline_summary, args):
+    """Print the comparison of 'summary' with 'baseline_summary', return the
+    number of regressions."""
+    number_of_regressions = 0
+    rows = []
+    for test_name, test_results in summary["Results"].items():
+        baseline_test_results = baseline_summary["Results"].get(test_name, {})
+        for instance, instance_results in test_results.items():
+            baseline_instance_results = baseline_test_results.get(instance)
+            if baseline_instance_results is None:
+                continue
+            for metric, sample in instance_results.items():
+                baseline_sample = baseline_instance_results.get(metric)
+                if not baseline_sample or not sample:
+                    continue
+                baseline_median = statistics.median(baseline_sample)
+                median = statistics.median(sample)
+                if baseline_median != 0:
+                    relative_change = (median - baseline_median) / abs(baseline_median)
+                else:
+                    relative_change = 0.0 if median == 0 else math.inf
+                p_value = mann_whitney_u_test(sample, baseline_sample)
+                status = ""
+                if p_value < args.significance_level:
+                    if relative_change > args.minimum_relative_change:
+                        status = "REGRESSION"
+                        number_of_regressions += 1
+                    elif relative_change < -args.minimum_relative_change:
+                        status = "improvement"
+                if status or args.verbose:
+                    rows.append((
+                        test_name + " " + instance,
+                        metric,
+                        baseline_median,
+                        median,
+                        relative_change,
+                        p_value,
+                        status))
+
+    print()
+    print("Comparison")
+    print("----------")
+    print()
+    print(f"{'Instance':60}{'Metric':38}{'Baseline':>14}{'New':>14}{'Change':>10}{'p-value':>10}  Status")
+    for instance, metric, baseline_median, median, relative_change, p_value, status in rows:
+        print(f"{instance:60}{metric:38}{baseline_median:14.6g}{median:14.6g}{relative_change:10.1%}{p_value:10.4f}  {status}")
+    print()
+    print(f"Number of regressions: {number_of_regressions}")
+    return number_of_regressions
+
+
+if __name__ == "__main__":
+
+    parser = argparse.ArgumentParser(description='')
+    parser.add_argument('directory')
+    parser.add_argument(
+            "-t", "--tests",
+            type=str,
+            nargs='*',
+            help='tests to run (default: all)')
+    parser.add_argument(
+            "-r", "--repetitions",
+            type=int,
+            default=5,
+            help='number of runs of each instance')
+    parser.add_argument(
+            "-b", "--baseline",
+            type=str,
+            help='directory of the baseline results')
+    parser.add_argument(
+            "--compare-only",
+            action='store_true',
+            help='compare the results already in the directory, without running anything')
+    parser.add_argument(
+            "--significance-level",
+            type=float,
+            default=0.05,
+            help='significance level of the statistical test')
+    parser.add_argument(
+            "--minimum-relative-change",
+            type=float,
+            default=0.05,
+            help='minimum relative change of the median reported')
+    parser.add_argument(
+            "-v", "--verbose",
+            action='store_true',
+            help='print all the metrics, not only the significant changes')
+
+    args = parser.parse_args()
+
+    if args.compare_only:
+        with open(os.path.join(args.directory, SUMMARY_FILE_NAME)) as summary_file:
+            summary = json.load(summary_file)
+    else:
+        summary = run(args)
+
+    if args.baseline is not None:
+        with open(os.path.join(args.baseline, SUMMARY_FILE_NAME)) as summary_file:
+            baseline_summary = json.load(summary_file)
+        if compare(summary, baseline_summary, args) > 0:
+            sys.exit(1)
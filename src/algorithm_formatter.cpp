@@ -1,5 +1,7 @@
 #include "columngenerationsolver/algorithm_formatter.hpp"
 
+#include "columngenerationsolver/event_stream.hpp"
+
 #include <iomanip>
 
 using namespace columngenerationsolver;
@@ -8,6 +10,12 @@ void AlgorithmFormatter::start(
         const std::string& algorithm_name)
 {
     output_.json["Parameters"] = parameters_.to_json();
+    if (parameters_.event_stream_writer != nullptr) {
+        parameters_.event_stream_writer->write(
+                "Start",
+                {{"Time", parameters_.timer.elapsed_time()},
+                 {"Algorithm", algorithm_name}});
+    }
 
     if (parameters_.verbosity_level == 0)
         return;
@@ -110,6 +118,52 @@ void AlgorithmFormatter::print_column_generation_iteration(
         << std::endl;
 }
 
+void AlgorithmFormatter::print_lagrangian_relaxation_header()
+{
+    if (parameters_.verbosity_level == 0)
+        return;
+    *os_
+        << std::endl
+        << "Lagrangian relaxation" << std::endl
+        << "---------------------" << std::endl
+        << std::endl
+        << std::right
+        << std::setw(12) << "Time"
+        << std::setw(8) << "Iter"
+        << std::setw(13) << "Lagrangian"
+        << std::setw(13) << "Bound"
+        << std::setw(13) << "Primal"
+        << std::setw(10) << "Step"
+        << std::endl
+        << std::setw(12) << "----"
+        << std::setw(8) << "----"
+        << std::setw(13) << "----------"
+        << std::setw(13) << "-----"
+        << std::setw(13) << "------"
+        << std::setw(10) << "----"
+        << std::endl;
+}
+
+void AlgorithmFormatter::print_lagrangian_relaxation_iteration(
+        Counter iteration,
+        Value lagrangian_value,
+        Value primal_value,
+        Value step_size_parameter)
+{
+    output_.time = parameters_.timer.elapsed_time();
+    if (parameters_.verbosity_level == 0)
+        return;
+    std::streamsize precision = std::cout.precision();
+    *os_
+        << std::setw(12) << std::fixed << std::setprecision(3) << output_.time << std::defaultfloat << std::setprecision(precision)
+        << std::setw(8) << iteration
+        << std::setw(13) << lagrangian_value
+        << std::setw(13) << output_.bound
+        << std::setw(13) << primal_value
+        << std::setw(10) << step_size_parameter
+        << std::endl;
+}
+
 void AlgorithmFormatter::print_greedy_header()
 {
     if (parameters_.verbosity_level == 0)
@@ -143,6 +197,9 @@ void AlgorithmFormatter::print_greedy_iteration(
         Value relaxation)
 {
     output_.time = parameters_.timer.elapsed_time();
+    write_node_event({
+            {"Node", node},
+            {"Relaxation", relaxation}});
     if (parameters_.verbosity_level == 0)
         return;
     std::streamsize precision = std::cout.precision();
@@ -196,6 +253,11 @@ void AlgorithmFormatter::print_limited_discrepancy_search_iteration(
         Value relaxation)
 {
     output_.time = parameters_.timer.elapsed_time();
+    write_node_event({
+            {"Node", node},
+            {"Depth", depth},
+            {"Discrepancy", discrepancy},
+            {"Relaxation", relaxation}});
     if (parameters_.verbosity_level == 0)
         return;
     std::streamsize precision = std::cout.precision();
@@ -248,6 +310,10 @@ void AlgorithmFormatter::print_branch_and_price_iteration(
         Value relaxation)
 {
     output_.time = parameters_.timer.elapsed_time();
+    write_node_event({
+            {"Node", node},
+            {"Depth", depth},
+            {"Relaxation", relaxation}});
     if (parameters_.verbosity_level == 0)
         return;
     std::streamsize precision = std::cout.precision();
@@ -275,6 +341,14 @@ void AlgorithmFormatter::update_solution(
         output_.time = parameters_.timer.elapsed_time();
         output_.solution = solution;
         output_.json["IntermediaryOutputs"].push_back(output_.to_json());
+        if (parameters_.event_stream_writer != nullptr) {
+            parameters_.event_stream_writer->write(
+                    "NewSolution",
+                    {{"Time", output_.time},
+                     {"Value", output_.solution_value()},
+                     {"Bound", output_.bound_string()},
+                     {"NumberOfColumns", solution.columns().size()}});
+        }
         parameters_.new_solution_callback(output_);
     }
 }
@@ -289,14 +363,66 @@ void AlgorithmFormatter::update_bound(
         output_.time = parameters_.timer.elapsed_time();
         output_.bound = bound;
         output_.json["IntermediaryOutputs"].push_back(output_.to_json());
+        if (parameters_.event_stream_writer != nullptr) {
+            parameters_.event_stream_writer->write(
+                    "NewBound",
+                    {{"Time", output_.time},
+                     {"Value", output_.solution_value()},
+                     {"Bound", output_.bound_string()}});
+        }
         parameters_.new_bound_callback(output_);
     }
 }
 
+void AlgorithmFormatter::update_memory_usage()
+{
+    output_.update_peak_memory_usage();
+    if (parameters_.verbosity_level == 0
+            || parameters_.memory_usage_log_interval < 0)
+        return;
+    double time = parameters_.timer.elapsed_time();
+    if (time < memory_usage_log_time_ + parameters_.memory_usage_log_interval)
+        return;
+    memory_usage_log_time_ = time;
+    output_.peak_resident_set_size = peak_resident_set_size();
+    const MemoryUsage& memory_usage = output_.memory_usage;
+    std::streamsize precision = std::cout.precision();
+    *os_
+        << std::right << std::setw(12) << std::fixed << std::setprecision(3) << time
+        << "  memory (MB):"
+        << " pool " << (double)memory_usage.column_pool / 1e6
+        << " columns " << (double)memory_usage.columns / 1e6
+        << " nodes " << (double)memory_usage.open_nodes / 1e6
+        << " LP " << (double)memory_usage.master_lp / 1e6
+        << " total " << (double)memory_usage.total() / 1e6
+        << " peak RSS " << ((output_.peak_resident_set_size == -1)? -1.0: (double)output_.peak_resident_set_size / 1e6)
+        << std::defaultfloat << std::setprecision(precision)
+        << std::endl;
+}
+
+void AlgorithmFormatter::write_node_event(
+        nlohmann::json event)
+{
+    if (parameters_.event_stream_writer == nullptr)
+        return;
+    event["Time"] = output_.time;
+    event["Value"] = output_.solution_value();
+    event["Bound"] = output_.bound_string();
+    parameters_.event_stream_writer->write("Node", std::move(event));
+}
+
 void AlgorithmFormatter::end()
 {
     output_.time = parameters_.timer.elapsed_time();
+    output_.peak_resident_set_size = peak_resident_set_size();
     output_.json["Output"] = output_.to_json();
+    if (parameters_.event_stream_writer != nullptr) {
+        parameters_.event_stream_writer->write(
+                "End",
+                {{"Time", output_.time},
+                 {"Value", output_.solution_value()},
+                 {"Bound", output_.bound_string()}});
+    }
 
     if (parameters_.verbosity_level == 0)
         return;
@@ -2,7 +2,14 @@
 
 #include "columngenerationsolver/algorithm_formatter.hpp"
 
+#include "trace_events.hpp"
+
+#include <map>
 #include <set>
+#include <unordered_set>
+#include <unordered_map>
+#include <fstream>
+#include <cstdio>
 #include <cmath>
 
 using namespace columngenerationsolver;
@@ -27,19 +34,47 @@ struct BranchAndPriceNode
      */
     Value bound = 0.0;
 
-    /** Relaxation solution of the node, once solved. */
-    std::shared_ptr<Solution> relaxation_solution;
+    /**
+     * Columns to warm-start this node with: the non-static columns with a
+     * nonzero value in the parent's relaxation solution, as indices in the
+     * branch-and-price column pool.
+     *
+     * Each node only keeps this compact copy rather than its parent's
+     * relaxation solution, so that a node's relaxation solution can be
+     * released as soon as its children have been created. Empty while
+     * spilled (see 'spill_position').
+     */
+    std::vector<ColIdx> initial_column_ids;
+
+    /**
+     * Cuts to warm-start this node with: the cuts active at the end of the
+     * parent's solve, as indices in the branch-and-price cut registry. Only
+     * the parent's own final active set ('ColumnGenerationOutput::cuts'),
+     * not a tree-wide pool: a cut separated on one branch isn't
+     * necessarily relevant, let alone valid, on an unrelated branch (e.g. a
+     * non-robust cut derived using this branch's fixed columns / branching
+     * decisions), so only a node's own lineage should ever see it — same
+     * reasoning as 'limited_discrepancy_search.cpp'.
+     */
+    std::vector<CutIdx> initial_cut_ids;
+
+    /**
+     * Stability center to warm-start the dual smoothing of this node with:
+     * the parent's final one (see 'ColumnGenerationOutput::
+     * stability_center'), shared with the siblings. 'nullptr' while
+     * spilled.
+     */
+    std::shared_ptr<const std::vector<Value>> initial_stability_center;
+
+    /** Wentges smoothing parameter matching 'initial_stability_center'. */
+    Value initial_wentges_smoothing_parameter = -1;
 
     /**
-     * Cuts active at this node: exactly this node's own
-     * 'ColumnGenerationOutput::cuts' (already the full final active set,
-     * self-contained), not a tree-wide pool. A cut separated on one branch
-     * isn't necessarily relevant, let alone valid, on an unrelated branch
-     * (e.g. a non-robust cut derived using this branch's fixed columns /
-     * branching decisions), so only a node's own lineage should ever see
-     * it — same reasoning as 'limited_discrepancy_search.cpp'.
+     * Position of 'initial_column_ids', 'initial_cut_ids' and a reference
+     * to 'initial_stability_center' in the spill file if they have been
+     * written there, -1 if they are in memory.
      */
-    std::vector<std::shared_ptr<const Cut>> cuts;
+    int64_t spill_position = -1;
 
     /**
      * Branching decision(s) that produce this node from its parent (empty
@@ -51,6 +86,318 @@ struct BranchAndPriceNode
      * technique, used by limited_discrepancy_search.
      */
     std::vector<std::shared_ptr<const BranchingDecision>> branching_decisions;
+
+    /**
+     * Columns excluded by reduced-cost fixing at this node, once solved.
+     * Node-local like 'branching_decisions': the argument only holds for
+     * this node's subtree, so they are only ever collected by walking a
+     * node's ancestry, never accumulated globally.
+     */
+    std::vector<ColIdx> reduced_cost_fixed_column_ids;
+};
+
+/**
+ * Approximate memory used by an open node, not counting the branching
+ * decisions themselves, which are shared with the pricing solver, nor the
+ * stability center, which is shared with the siblings and counted once for
+ * all of them by 'branch_and_price'.
+ */
+Counter memory(const BranchAndPriceNode& node)
+{
+    return sizeof(BranchAndPriceNode)
+        + node.initial_column_ids.capacity() * sizeof(ColIdx)
+        + node.initial_cut_ids.capacity() * sizeof(CutIdx)
+        + node.branching_decisions.capacity() * sizeof(std::shared_ptr<const BranchingDecision>)
+        + node.reduced_cost_fixed_column_ids.capacity() * sizeof(ColIdx);
+}
+
+/**
+ * File where the warm-start data of the least promising open nodes is
+ * written when the open nodes exceed their memory budget.
+ *
+ * A stability center shared by several spilled nodes (siblings) is written
+ * once, in its own record, and read back once for all of them.
+ *
+ * A record is freed once read back. The freed extents are reused by the
+ * next records that fit in them, and the file is truncated whenever no
+ * record is left, so that its size stays bounded by the records of the
+ * nodes currently spilled. The file is removed at the end of the search.
+ */
+class BranchAndPriceNodeSpillFile
+{
+
+public:
+
+    /** Constructor. */
+    BranchAndPriceNodeSpillFile(const std::string& path):
+        path_(path) { }
+
+    /** Destructor. */
+    ~BranchAndPriceNodeSpillFile()
+    {
+        if (file_.is_open()) {
+            file_.close();
+            std::remove(path_.c_str());
+        }
+    }
+
+    /** Move the warm-start data of a node to the file. */
+    void write(BranchAndPriceNode& node)
+    {
+        if (!file_.is_open())
+            open();
+        int64_t header[3] = {
+            (int64_t)node.initial_column_ids.size(),
+            (int64_t)node.initial_cut_ids.size(),
+            write_stability_center(node.initial_stability_center)};
+        node.spill_position = allocate(record_size(header));
+        file_.seekp(node.spill_position);
+        file_.write((const char*)header, sizeof(header));
+        file_.write(
+                (const char*)node.initial_column_ids.data(),
+                node.initial_column_ids.size() * sizeof(ColIdx));
+        file_.write(
+                (const char*)node.initial_cut_ids.data(),
+                node.initial_cut_ids.size() * sizeof(CutIdx));
+        if (!file_.good()) {
+            throw std::runtime_error(
+                    "columngenerationsolver::branch_and_price: "
+                    "unable to write spill file \"" + path_ + "\".");
+        }
+        std::vector<ColIdx>().swap(node.initial_column_ids);
+        std::vector<CutIdx>().swap(node.initial_cut_ids);
+        node.initial_stability_center = nullptr;
+        number_of_records_++;
+    }
+
+    /** Read back the warm-start data of a spilled node. */
+    void read(BranchAndPriceNode& node)
+    {
+        file_.seekg(node.spill_position);
+        int64_t header[3];
+        file_.read((char*)header, sizeof(header));
+        node.initial_column_ids.resize(header[0]);
+        node.initial_cut_ids.resize(header[1]);
+        file_.read(
+                (char*)node.initial_column_ids.data(),
+                node.initial_column_ids.size() * sizeof(ColIdx));
+        file_.read(
+                (char*)node.initial_cut_ids.data(),
+                node.initial_cut_ids.size() * sizeof(CutIdx));
+        if (header[2] != -1)
+            node.initial_stability_center = read_stability_center(header[2]);
+        if (!file_.good()) {
+            throw std::runtime_error(
+                    "columngenerationsolver::branch_and_price: "
+                    "unable to read spill file \"" + path_ + "\".");
+        }
+        number_of_records_--;
+        if (number_of_records_ == 0) {
+            // Nothing left: start over from an empty file.
+            file_.close();
+            open();
+        } else {
+            release(node.spill_position, record_size(header));
+        }
+        node.spill_position = -1;
+    }
+
+private:
+
+    /** Stability center written in the file. */
+    struct SpilledStabilityCenter
+    {
+        /** Stability center, if it is in memory. */
+        std::weak_ptr<const std::vector<Value>> stability_center;
+
+        /** Address of the stability center it has been written from. */
+        const std::vector<Value>* address;
+
+        /** Number of spilled nodes with this stability center. */
+        Counter number_of_nodes = 0;
+    };
+
+    /**
+     * Return the position of the record of a stability center, -1 if there
+     * is none. The record is only written if the stability center isn't in
+     * the file already.
+     */
+    int64_t write_stability_center(
+            const std::shared_ptr<const std::vector<Value>>& stability_center)
+    {
+        if (stability_center == nullptr)
+            return -1;
+        auto it = stability_center_positions_.find(stability_center.get());
+        if (it != stability_center_positions_.end()) {
+            SpilledStabilityCenter& spilled_stability_center = stability_centers_.at(it->second);
+            // The address may have been reused by another stability center
+            // once all the nodes sharing the spilled one have been spilled.
+            if (spilled_stability_center.stability_center.lock() == stability_center) {
+                spilled_stability_center.number_of_nodes++;
+                return it->second;
+            }
+        }
+        int64_t size = stability_center->size();
+        int64_t position = allocate(stability_center_record_size(size));
+        file_.seekp(position);
+        file_.write((const char*)&size, sizeof(size));
+        file_.write(
+                (const char*)stability_center->data(),
+                size * sizeof(Value));
+        SpilledStabilityCenter& spilled_stability_center = stability_centers_[position];
+        spilled_stability_center.stability_center = stability_center;
+        spilled_stability_center.address = stability_center.get();
+        spilled_stability_center.number_of_nodes = 1;
+        stability_center_positions_[stability_center.get()] = position;
+        return position;
+    }
+
+    /**
+     * Return the stability center of the record at 'position', shared with
+     * the nodes read back before if it is still in memory.
+     */
+    std::shared_ptr<const std::vector<Value>> read_stability_center(
+            int64_t position)
+    {
+        SpilledStabilityCenter& spilled_stability_center = stability_centers_.at(position);
+        std::shared_ptr<const std::vector<Value>> stability_center
+            = spilled_stability_center.stability_center.lock();
+        if (stability_center == nullptr) {
+            forget_address(spilled_stability_center.address, position);
+            int64_t size = 0;
+            file_.seekg(position);
+            file_.read((char*)&size, sizeof(size));
+            auto stability_center_tmp = std::make_shared<std::vector<Value>>(size);
+            file_.read(
+                    (char*)stability_center_tmp->data(),
+                    size * sizeof(Value));
+            stability_center = stability_center_tmp;
+            spilled_stability_center.stability_center = stability_center;
+            spilled_stability_center.address = stability_center.get();
+            stability_center_positions_[stability_center.get()] = position;
+        }
+        spilled_stability_center.number_of_nodes--;
+        if (spilled_stability_center.number_of_nodes == 0) {
+            forget_address(spilled_stability_center.address, position);
+            stability_centers_.erase(position);
+            release(position, stability_center_record_size(stability_center->size()));
+        }
+        return stability_center;
+    }
+
+    /**
+     * Remove the address of the stability center of the record at
+     * 'position', unless it has been reused by another one since.
+     */
+    void forget_address(
+            const std::vector<Value>* address,
+            int64_t position)
+    {
+        auto it = stability_center_positions_.find(address);
+        if (it != stability_center_positions_.end() && it->second == position)
+            stability_center_positions_.erase(it);
+    }
+
+    /** Open the file, empty. */
+    void open()
+    {
+        file_.open(
+                path_,
+                std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file_.good()) {
+            throw std::runtime_error(
+                    "columngenerationsolver::branch_and_price: "
+                    "unable to open spill file \"" + path_ + "\".");
+        }
+        free_extents_.clear();
+        end_ = 0;
+        stability_centers_.clear();
+        stability_center_positions_.clear();
+    }
+
+    /** Size of the record of a node given the header written at its start. */
+    static int64_t record_size(const int64_t* header)
+    {
+        return 3 * sizeof(int64_t)
+            + header[0] * sizeof(ColIdx)
+            + header[1] * sizeof(CutIdx);
+    }
+
+    /** Size of the record of a stability center of 'size' values. */
+    static int64_t stability_center_record_size(int64_t size)
+    {
+        return sizeof(int64_t) + size * sizeof(Value);
+    }
+
+    /**
+     * Return the position of a new record of 'size' bytes: the start of the
+     * first free extent large enough, or the end of the used part of the
+     * file.
+     */
+    int64_t allocate(int64_t size)
+    {
+        for (auto it = free_extents_.begin(); it != free_extents_.end(); ++it) {
+            if (it->second < size)
+                continue;
+            int64_t position = it->first;
+            int64_t remaining_size = it->second - size;
+            free_extents_.erase(it);
+            if (remaining_size > 0)
+                free_extents_[position + size] = remaining_size;
+            return position;
+        }
+        int64_t position = end_;
+        end_ += size;
+        return position;
+    }
+
+    /** Free the record of 'size' bytes at 'position'. */
+    void release(int64_t position, int64_t size)
+    {
+        // Merge with the next free extent.
+        auto it_next = free_extents_.find(position + size);
+        if (it_next != free_extents_.end()) {
+            size += it_next->second;
+            free_extents_.erase(it_next);
+        }
+        // Merge with the previous free extent.
+        auto it = free_extents_.lower_bound(position);
+        if (it != free_extents_.begin()) {
+            auto it_prev = std::prev(it);
+            if (it_prev->first + it_prev->second == position) {
+                position = it_prev->first;
+                size += it_prev->second;
+                free_extents_.erase(it_prev);
+            }
+        }
+        if (position + size == end_) {
+            end_ = position;
+        } else {
+            free_extents_[position] = size;
+        }
+    }
+
+    /** Path of the file. */
+    std::string path_;
+
+    /** File. */
+    std::fstream file_;
+
+    /** Number of records not read back yet. */
+    Counter number_of_records_ = 0;
+
+    /** Free extents before 'end_', by position, with their sizes. */
+    std::map<int64_t, int64_t> free_extents_;
+
+    /** End of the used part of the file. */
+    int64_t end_ = 0;
+
+    /** Stability centers written in the file, by position. */
+    std::unordered_map<int64_t, SpilledStabilityCenter> stability_centers_;
+
+    /** Positions of the stability centers written in the file, by address. */
+    std::unordered_map<const std::vector<Value>*, int64_t> stability_center_positions_;
+
 };
 
 }
@@ -59,6 +406,7 @@ const BranchAndPriceOutput columngenerationsolver::branch_and_price(
         const Model& model,
         const BranchAndPriceParameters& parameters)
 {
+    COLUMNGENERATIONSOLVER_TRACE_SCOPE("branch_and_price");
     // Initial display.
     BranchAndPriceOutput output(model);
     AlgorithmFormatter algorithm_formatter(
@@ -70,7 +418,29 @@ const BranchAndPriceOutput columngenerationsolver::branch_and_price(
 
     bool minimize = (model.objective_sense == optimizationtools::ObjectiveDirection::Minimize);
 
-    std::vector<std::shared_ptr<const Column>> column_pool = parameters.column_pool;
+    // Column pool, shared by the column generation calls of all the nodes
+    // and strong-branching evaluations. Nodes refer to its columns by
+    // index.
+    ColumnPool column_pool(model, parameters.column_pool);
+
+    // Cut registry, so that nodes can refer to cuts by index.
+    std::vector<std::shared_ptr<const Cut>> cut_pool;
+    std::unordered_map<const Cut*, CutIdx> cut_ids;
+    auto cut_id = [&cut_pool, &cut_ids](
+            const std::shared_ptr<const Cut>& cut)
+    {
+        auto it = cut_ids.find(cut.get());
+        if (it != cut_ids.end())
+            return it->second;
+        CutIdx id = cut_pool.size();
+        cut_ids[cut.get()] = id;
+        cut_pool.push_back(cut);
+        return id;
+    };
+
+    std::unordered_set<const Column*> static_columns;
+    for (const auto& column: model.static_columns)
+        static_columns.insert(column.get());
 
     // Open-node queue, ordered best-bound-first (sense-aware). The global
     // dual bound at any point is the bound of the node at the front of the
@@ -91,33 +461,124 @@ const BranchAndPriceOutput columngenerationsolver::branch_and_price(
     };
     std::multiset<std::shared_ptr<BranchAndPriceNode>, decltype(comp)> nodes(comp);
 
+    // Memory used by the open nodes. When it exceeds the budget, the
+    // warm-start data of the least promising open nodes, i.e. the ones at
+    // the back of the queue, is spilled to disk.
+    // A stability center is counted once for all the open nodes sharing it;
+    // 'open_stability_centers' holds their number by stability center.
+    Counter open_nodes_memory = 0;
+    std::unordered_map<const std::vector<Value>*, Counter> open_stability_centers;
+    auto add_open_node_memory = [
+            &open_nodes_memory,
+            &open_stability_centers](
+                const BranchAndPriceNode& node)
+    {
+        open_nodes_memory += memory(node);
+        if (node.initial_stability_center != nullptr
+                && open_stability_centers[node.initial_stability_center.get()]++ == 0) {
+            open_nodes_memory += node.initial_stability_center->capacity() * sizeof(Value);
+        }
+    };
+    auto remove_open_node_memory = [
+            &open_nodes_memory,
+            &open_stability_centers](
+                const BranchAndPriceNode& node)
+    {
+        open_nodes_memory -= memory(node);
+        if (node.initial_stability_center != nullptr) {
+            auto it = open_stability_centers.find(node.initial_stability_center.get());
+            if (--it->second == 0) {
+                open_stability_centers.erase(it);
+                open_nodes_memory -= node.initial_stability_center->capacity() * sizeof(Value);
+            }
+        }
+    };
+    BranchAndPriceNodeSpillFile spill_file(parameters.open_nodes_spill_path);
+    auto insert_node = [
+            &parameters,
+            &output,
+            &nodes,
+            &open_nodes_memory,
+            &add_open_node_memory,
+            &remove_open_node_memory,
+            &spill_file](
+                const std::shared_ptr<BranchAndPriceNode>& node)
+    {
+        nodes.insert(node);
+        add_open_node_memory(*node);
+        if (parameters.open_nodes_memory_limit == -1
+                || parameters.open_nodes_spill_path.empty()) {
+            return;
+        }
+        for (auto it = nodes.rbegin();
+                it != nodes.rend()
+                && open_nodes_memory > parameters.open_nodes_memory_limit;
+                ++it) {
+            BranchAndPriceNode& node_tmp = **it;
+            if (node_tmp.spill_position != -1
+                    || (node_tmp.initial_column_ids.empty()
+                        && node_tmp.initial_cut_ids.empty()
+                        && node_tmp.initial_stability_center == nullptr)) {
+                continue;
+            }
+            remove_open_node_memory(node_tmp);
+            spill_file.write(node_tmp);
+            add_open_node_memory(node_tmp);
+            output.number_of_spilled_nodes++;
+        }
+    };
+
     // Root node.
     auto root = std::make_shared<BranchAndPriceNode>();
     root->bound = (minimize)?
         -std::numeric_limits<Value>::infinity():
         +std::numeric_limits<Value>::infinity();
-    nodes.insert(root);
+    insert_node(root);
+
+    // Child selected by plunging, to be processed next instead of the
+    // front of 'nodes'. Not in 'nodes' itself.
+    std::shared_ptr<BranchAndPriceNode> plunging_node = nullptr;
+
+    // Master LP kept alive while each node processed is a child of the
+    // previous one, dropped as soon as the search jumps elsewhere.
+    std::shared_ptr<ColumnGenerationMaster> master = nullptr;
+    std::shared_ptr<BranchAndPriceNode> node_prev = nullptr;
 
-    while (!nodes.empty()) {
+    while (!nodes.empty() || plunging_node != nullptr) {
 
         // Check end.
         if (parameters.timer.needs_to_end())
             break;
 
         // Get node.
-        auto node = *nodes.begin();
-        nodes.erase(nodes.begin());
+        std::shared_ptr<BranchAndPriceNode> node = nullptr;
+        if (plunging_node != nullptr) {
+            node = plunging_node;
+            plunging_node = nullptr;
+            output.number_of_plunged_nodes++;
+        } else {
+            node = *nodes.begin();
+            nodes.erase(nodes.begin());
+            remove_open_node_memory(*node);
+        }
+        if (node->spill_position != -1)
+            spill_file.read(*node);
+        if (master == nullptr || node->parent == nullptr || node->parent != node_prev)
+            master = create_column_generation_master();
+        node_prev = node;
         output.number_of_nodes++;
         if (output.maximum_depth < node->depth)
             output.maximum_depth = node->depth;
 
-        // Reconstruct this node's branching_decisions by walking its
-        // ancestry (like the "Compute fixed_columns and tabu" block in
-        // limited_discrepancy_search.cpp), since these are node-local and
-        // must never be accumulated globally.
+        // Reconstruct this node's branching_decisions and reduced-cost
+        // fixed columns by walking its ancestry (like the "Compute
+        // fixed_columns and tabu" block in limited_discrepancy_search.cpp),
+        // since these are node-local and must never be accumulated
+        // globally.
         std::vector<std::shared_ptr<const BranchingDecision>> branching_decisions;
+        std::unordered_set<std::shared_ptr<const Column>> tabu;
         for (auto node_tmp = node;
-                node_tmp->parent != nullptr;
+                node_tmp != nullptr;
                 node_tmp = node_tmp->parent) {
             if (!node_tmp->branching_decisions.empty()) {
                 branching_decisions.insert(
@@ -125,6 +586,17 @@ const BranchAndPriceOutput columngenerationsolver::branch_and_price(
                         node_tmp->branching_decisions.begin(),
                         node_tmp->branching_decisions.end());
             }
+            for (ColIdx column_id: node_tmp->reduced_cost_fixed_column_ids)
+                tabu.insert(column_pool.column(column_id));
+        }
+
+        // Gap between the incumbent and this node's bound, passed to the
+        // pricing solver (see 'PricingSolver::initialize_pricing').
+        Value gap = std::numeric_limits<Value>::infinity();
+        if (output.solution.feasible()) {
+            gap = (minimize)?
+                output.solution.objective_value() - node->bound:
+                node->bound - output.solution.objective_value();
         }
 
         // (Re-)solve this node to full convergence: a strong-branching
@@ -141,29 +613,45 @@ const BranchAndPriceOutput columngenerationsolver::branch_and_price(
         // having to decide whether cutting planes — which strong-branching
         // evaluations don't even run, see below — would have finished
         // separating by the time the cap hit.
+        //
+        // The relaxation solution and the cuts of the node are only kept
+        // until its children have been created.
+        std::unique_ptr<Solution> relaxation_solution;
+        std::vector<std::shared_ptr<const Cut>> node_cuts;
+        std::shared_ptr<const std::vector<Value>> stability_center;
+        Value wentges_smoothing_parameter = -1;
+        std::vector<Value> node_duals;
         {
+            COLUMNGENERATIONSOLVER_TRACE_SCOPE("node");
             ColumnGenerationParameters column_generation_parameters
                 = parameters.column_generation_parameters;
             column_generation_parameters.timer = parameters.timer;
             column_generation_parameters.verbosity_level = 0;
+            column_generation_parameters.node_id = output.number_of_nodes;
             if (node->parent == nullptr) {
                 column_generation_parameters.initial_columns = parameters.initial_columns;
-            } else if (node->parent->relaxation_solution != nullptr) {
-                for (const auto& p: node->parent->relaxation_solution->columns()) {
-                    bool ok = true;
-                    for (const auto& column: model.static_columns)
-                        if (p.first.get() == column.get())
-                            ok = false;
-                    if (ok)
-                        column_generation_parameters.initial_columns.push_back(p.first);
+                column_generation_parameters.initial_cuts = parameters.initial_cuts;
+            } else {
+                column_generation_parameters.tailing_off = parameters.non_root_tailing_off;
+                for (ColIdx column_id: node->initial_column_ids)
+                    column_generation_parameters.initial_columns.push_back(column_pool.column(column_id));
+                for (CutIdx cut_id: node->initial_cut_ids)
+                    column_generation_parameters.initial_cuts.push_back(cut_pool[cut_id]);
+                if (node->initial_stability_center != nullptr) {
+                    column_generation_parameters.initial_stability_center = *node->initial_stability_center;
+                    column_generation_parameters.initial_wentges_smoothing_parameter = node->initial_wentges_smoothing_parameter;
                 }
             }
-            column_generation_parameters.column_pool = column_pool;
-            column_generation_parameters.initial_cuts = (node->parent == nullptr)?
-                parameters.initial_cuts:
-                node->parent->cuts;
+            // Not needed anymore once the node has been solved.
+            std::vector<ColIdx>().swap(node->initial_column_ids);
+            std::vector<CutIdx>().swap(node->initial_cut_ids);
+            node->initial_stability_center = nullptr;
+            column_generation_parameters.shared_column_pool = &column_pool;
             column_generation_parameters.fixed_columns = parameters.fixed_columns;
             column_generation_parameters.branching_decisions = branching_decisions;
+            column_generation_parameters.tabu = &tabu;
+            column_generation_parameters.reduced_cost_fixing_gap = gap;
+            column_generation_parameters.master = master;
             if (node->parent == nullptr) {
                 column_generation_parameters.phase_callback = [&algorithm_formatter](
                         bool solve_feasibility)
@@ -188,16 +676,28 @@ const BranchAndPriceOutput columngenerationsolver::branch_and_price(
 
             output.time_lpsolve += cg_output.time_lpsolve;
             output.time_pricing += cg_output.time_pricing;
+            output.time_rounding_heuristic += cg_output.time_rounding_heuristic;
+            output.add_master_statistics(cg_output);
             output.number_of_column_generation_iterations += cg_output.number_of_column_generation_iterations;
             output.columns.insert(
                     output.columns.end(),
                     cg_output.columns.begin(),
                     cg_output.columns.end());
-            column_pool.insert(
-                    column_pool.end(),
-                    cg_output.columns.begin(),
-                    cg_output.columns.end());
-            node->cuts = cg_output.cuts;
+            // The master LP stays alive while plunging.
+            output.memory_usage.column_pool = column_pool.memory();
+            output.memory_usage.columns = output.columns.capacity() * sizeof(std::shared_ptr<const Column>);
+            output.memory_usage.open_nodes = open_nodes_memory;
+            output.memory_usage.master_lp = cg_output.memory_usage.master_lp;
+            algorithm_formatter.update_memory_usage();
+            node_cuts = cg_output.cuts;
+            node_duals = cg_output.duals;
+            if (node_duals.empty() && !cg_output.stability_center.empty())
+                node_duals = cg_output.stability_center;
+            if (!cg_output.stability_center.empty()) {
+                stability_center = std::make_shared<const std::vector<Value>>(
+                        std::move(cg_output.stability_center));
+                wentges_smoothing_parameter = cg_output.wentges_smoothing_parameter;
+            }
 
             if (parameters.timer.needs_to_end())
                 break;
@@ -208,23 +708,53 @@ const BranchAndPriceOutput columngenerationsolver::branch_and_price(
             }
 
             node->bound = cg_output.bound;
-            node->relaxation_solution = std::shared_ptr<Solution>(new Solution(cg_output.relaxation_solution));
+            relaxation_solution.reset(new Solution(cg_output.relaxation_solution));
 
             if (node->parent == nullptr) {
                 algorithm_formatter.print_branch_and_price_header();
-                output.relaxation_solution = *node->relaxation_solution;
+                output.relaxation_solution = *relaxation_solution;
+            }
+
+            // Reduced-cost fixing. With 'duals' the converged duals of the
+            // node and 'duals_bound' the dual bound they give, any solution
+            // of this node's subtree using a column at value >= 1 costs at
+            // least 'duals_bound' plus the column's reduced cost: once that
+            // exceeds the incumbent, the column can't be part of an
+            // improving solution anywhere below this node.
+            if (parameters.reduced_cost_fixing
+                    && output.solution.feasible()
+                    && !cg_output.duals.empty()
+                    && cg_output.duals_bound != std::numeric_limits<Value>::infinity()
+                    && cg_output.duals_bound != -std::numeric_limits<Value>::infinity()) {
+                Value node_gap = (minimize)?
+                    output.solution.objective_value() - cg_output.duals_bound:
+                    cg_output.duals_bound - output.solution.objective_value();
+                for (ColIdx column_id = 0;
+                        column_id < column_pool.number_of_columns();
+                        ++column_id) {
+                    const auto& column = column_pool.column(column_id);
+                    if (tabu.find(column) != tabu.end())
+                        continue;
+                    Value rc = model.compute_reduced_cost(false, *column, cg_output.duals, cg_output.cut_duals);
+                    Value loss = (minimize)? rc: -rc;
+                    if (loss > node_gap + FFOT_TOL) {
+                        node->reduced_cost_fixed_column_ids.push_back(column_id);
+                        // Strong-branching evaluations below are already
+                        // in the subtree.
+                        tabu.insert(column);
+                    }
+                }
+                output.number_of_reduced_cost_fixed_columns += node->reduced_cost_fixed_column_ids.size();
             }
         }
 
-        // Report the global bound. This node had the best bound among all
-        // open nodes *at the time it was popped* — but resolving it above
-        // to full convergence may have revised its bound upward (worse,
-        // for minimization), since it was only selected using a loose
-        // strong-branching estimate. That revised bound is not necessarily
-        // the true minimum over everything still open, so compare against
-        // whatever now sits at the front of the queue (itself a valid,
-        // if possibly still loose, lower bound) and report the better of
-        // the two — never just the popped node in isolation.
+        // Report the global bound. The popped node is not necessarily the
+        // one with the best bound among the open nodes: it may be a child
+        // taken directly by plunging rather than from the front of the
+        // queue, and resolving it above may also have revised its bound.
+        // The open nodes are the popped node and the nodes in the queue,
+        // so the global bound is the better of its bound and the bound of
+        // the node at the front of the queue.
         Value global_bound = node->bound;
         if (!nodes.empty()) {
             global_bound = (minimize)?
@@ -236,7 +766,7 @@ const BranchAndPriceOutput columngenerationsolver::branch_and_price(
         // Every popped node is always fully re-solved above (any
         // infeasible resolve already 'continue'd before reaching here), so
         // 'relaxation_solution' is guaranteed non-null at this point.
-        Value relaxation = node->relaxation_solution->objective_value();
+        Value relaxation = relaxation_solution->objective_value();
 
         // Prune if this node cannot improve on the incumbent.
         if (output.solution.feasible()) {
@@ -252,8 +782,8 @@ const BranchAndPriceOutput columngenerationsolver::branch_and_price(
 
         // If the relaxation is already integer feasible, it's a new
         // incumbent; no children.
-        if (node->relaxation_solution->feasible()) {
-            algorithm_formatter.update_solution(*node->relaxation_solution);
+        if (relaxation_solution->feasible()) {
+            algorithm_formatter.update_solution(*relaxation_solution);
             algorithm_formatter.print_branch_and_price_iteration(output.number_of_nodes, node->depth, relaxation);
             continue;
         }
@@ -266,7 +796,7 @@ const BranchAndPriceOutput columngenerationsolver::branch_and_price(
         // branching_decisions'): the pricing solver must provide branching
         // candidates for every fractional relaxation it can be handed.
         auto decision_candidates = model.pricing_solver->compute_branching_candidates(
-                *node->relaxation_solution);
+                *relaxation_solution);
         if (decision_candidates.empty()) {
             throw std::runtime_error(
                     "columngenerationsolver::branch_and_price: "
@@ -296,6 +826,15 @@ const BranchAndPriceOutput columngenerationsolver::branch_and_price(
             decision_candidates.resize(parameters.maximum_number_of_branching_candidates);
         }
 
+        // Warm-start data of the children.
+        std::vector<ColIdx> relaxation_column_ids;
+        for (const auto& p: relaxation_solution->columns())
+            if (static_columns.find(p.first.get()) == static_columns.end())
+                relaxation_column_ids.push_back(column_pool.add(p.first).first);
+        std::vector<CutIdx> relaxation_cut_ids;
+        for (const auto& cut: node_cuts)
+            relaxation_cut_ids.push_back(cut_id(cut));
+
         std::vector<std::vector<std::shared_ptr<BranchAndPriceNode>>> node_candidates;
         for (const auto& candidate: decision_candidates) {
             std::vector<std::shared_ptr<BranchAndPriceNode>> children;
@@ -316,6 +855,7 @@ const BranchAndPriceOutput columngenerationsolver::branch_and_price(
         Value best_score = -std::numeric_limits<Value>::infinity();
         std::vector<std::shared_ptr<BranchAndPriceNode>> best_children;
         for (const auto& children: node_candidates) {
+            COLUMNGENERATIONSOLVER_TRACE_SCOPE("strong_branching_candidate");
             Value score = std::numeric_limits<Value>::infinity();
             for (const auto& child: children) {
                 std::vector<std::shared_ptr<const BranchingDecision>> child_branching_decisions
@@ -325,22 +865,64 @@ const BranchAndPriceOutput columngenerationsolver::branch_and_price(
                         child->branching_decisions.begin(),
                         child->branching_decisions.end());
 
+                if (parameters.lagrangian_strong_branching) {
+                    LagrangianRelaxationParameters lagrangian_relaxation_parameters;
+                    lagrangian_relaxation_parameters.timer = parameters.timer;
+                    lagrangian_relaxation_parameters.verbosity_level = 0;
+                    lagrangian_relaxation_parameters.shared_column_pool = &column_pool;
+                    lagrangian_relaxation_parameters.initial_duals = node_duals;
+                    lagrangian_relaxation_parameters.fixed_columns = parameters.fixed_columns;
+                    lagrangian_relaxation_parameters.branching_decisions = child_branching_decisions;
+                    lagrangian_relaxation_parameters.maximum_number_of_iterations
+                        = parameters.strong_branching_maximum_number_of_iterations;
+                    auto lagrangian_relaxation_output = lagrangian_relaxation(
+                            model,
+                            lagrangian_relaxation_parameters);
+
+                    output.time_pricing += lagrangian_relaxation_output.time_pricing;
+                    output.add_master_statistics(lagrangian_relaxation_output);
+                    output.columns.insert(
+                            output.columns.end(),
+                            lagrangian_relaxation_output.columns.begin(),
+                            lagrangian_relaxation_output.columns.end());
+
+                    if (parameters.timer.needs_to_end())
+                        break;
+
+                    // Clamped to the parent's bound, see below.
+                    child->bound = (minimize)?
+                        (std::max)(lagrangian_relaxation_output.bound, node->bound):
+                        (std::min)(lagrangian_relaxation_output.bound, node->bound);
+                    Value degradation = (minimize)?
+                        child->bound - node->bound:
+                        node->bound - child->bound;
+                    score = (std::min)(score, degradation);
+                    continue;
+                }
+
                 ColumnGenerationParameters column_generation_parameters
                     = parameters.column_generation_parameters;
                 column_generation_parameters.timer = parameters.timer;
                 column_generation_parameters.verbosity_level = 0;
-                for (const auto& p: node->relaxation_solution->columns()) {
-                    bool ok = true;
-                    for (const auto& column: model.static_columns)
-                        if (p.first.get() == column.get())
-                            ok = false;
-                    if (ok)
-                        column_generation_parameters.initial_columns.push_back(p.first);
+                column_generation_parameters.node_id = output.number_of_nodes;
+                column_generation_parameters.tailing_off = parameters.non_root_tailing_off;
+                for (ColIdx column_id: relaxation_column_ids)
+                    column_generation_parameters.initial_columns.push_back(column_pool.column(column_id));
+                column_generation_parameters.shared_column_pool = &column_pool;
+                column_generation_parameters.initial_cuts = node_cuts;
+                if (stability_center != nullptr) {
+                    column_generation_parameters.initial_stability_center = *stability_center;
+                    column_generation_parameters.initial_wentges_smoothing_parameter = wentges_smoothing_parameter;
                 }
-                column_generation_parameters.column_pool = column_pool;
-                column_generation_parameters.initial_cuts = node->cuts;
                 column_generation_parameters.fixed_columns = parameters.fixed_columns;
                 column_generation_parameters.branching_decisions = child_branching_decisions;
+                column_generation_parameters.tabu = &tabu;
+                column_generation_parameters.master = nullptr;
+                if (output.solution.feasible()) {
+                    column_generation_parameters.reduced_cost_fixing_gap = (minimize)?
+                        output.solution.objective_value() - node->bound:
+                        node->bound - output.solution.objective_value();
+                }
                 column_generation_parameters.maximum_number_of_iterations
                     = parameters.strong_branching_maximum_number_of_iterations;
                 // Strong-branching evaluations are capped, throwaway
@@ -359,15 +941,13 @@ const BranchAndPriceOutput columngenerationsolver::branch_and_price(
 
                 output.time_lpsolve += cg_output.time_lpsolve;
                 output.time_pricing += cg_output.time_pricing;
+                output.time_rounding_heuristic += cg_output.time_rounding_heuristic;
+                output.add_master_statistics(cg_output);
                 output.number_of_column_generation_iterations += cg_output.number_of_column_generation_iterations;
                 output.columns.insert(
                         output.columns.end(),
                         cg_output.columns.begin(),
                         cg_output.columns.end());
-                column_pool.insert(
-                        column_pool.end(),
-                        cg_output.columns.begin(),
-                        cg_output.columns.end());
 
                 if (parameters.timer.needs_to_end())
                     break;
@@ -409,11 +989,48 @@ const BranchAndPriceOutput columngenerationsolver::branch_and_price(
         if (parameters.timer.needs_to_end())
             break;
 
+        for (const auto& child: best_children) {
+            child->initial_column_ids = relaxation_column_ids;
+            child->initial_cut_ids = relaxation_cut_ids;
+            child->initial_stability_center = stability_center;
+            child->initial_wentges_smoothing_parameter = wentges_smoothing_parameter;
+        }
+
+        // Plunging: continue with the most promising child if its bound is
+        // close enough to the best bound of the open nodes (including the
+        // other children).
+        std::shared_ptr<BranchAndPriceNode> best_child = nullptr;
+        for (const auto& child: best_children)
+            if (best_child == nullptr || comp(child, best_child))
+                best_child = child;
         for (const auto& child: best_children)
-            nodes.insert(child);
+            if (child != best_child)
+                insert_node(child);
+        if (best_child != nullptr) {
+            bool plunge = false;
+            if (parameters.plunging_maximum_relative_gap >= 0) {
+                Value best_bound = best_child->bound;
+                if (!nodes.empty() && comp(*nodes.begin(), best_child))
+                    best_bound = (*nodes.begin())->bound;
+                if (best_child->bound == best_bound) {
+                    plunge = true;
+                } else {
+                    Value relative_gap = std::abs(best_child->bound - best_bound)
+                        / (std::max)(1.0, std::abs(best_bound));
+                    plunge = (relative_gap <= parameters.plunging_maximum_relative_gap);
+                }
+            }
+            if (plunge) {
+                plunging_node = best_child;
+            } else {
+                insert_node(best_child);
+            }
+        }
     }
 
-    output.optimal = nodes.empty() && !parameters.timer.needs_to_end();
+    output.optimal = nodes.empty()
+        && plunging_node == nullptr
+        && !parameters.timer.needs_to_end();
 
     algorithm_formatter.end();
     return output;
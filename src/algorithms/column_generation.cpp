@@ -3,9 +3,110 @@
 #include "columngenerationsolver/algorithm_formatter.hpp"
 
 #include "linear_programming_solver.hpp"
+#include "trace_events.hpp"
+
+#include <numeric>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 using namespace columngenerationsolver;
 
+namespace columngenerationsolver
+{
+
+struct ColumnGenerationMaster
+{
+    /** Linear programming solver. */
+    std::unique_ptr<LinearProgrammingSolver> solver;
+
+    /** Column of each LP variable ('nullptr' for dummy columns). */
+    std::vector<std::shared_ptr<const Column>> solver_columns;
+
+    /** Generated (i.e. non-static) columns in the LP. */
+    std::unordered_set<std::shared_ptr<const Column>> solver_generated_columns;
+
+    /**
+     * For each LP variable, whether it currently has its real bounds (1)
+     * or has been disabled by a later attempt through bounds [0, 0] (0).
+     * Only resized when the LP gets reused: variables added since then
+     * are enabled.
+     */
+    std::vector<int8_t> solver_columns_enabled;
+
+    /**
+     * Artificial columns of the penalty stabilization, if any: for the row
+     * at position 'row_pos' in 'new_rows', the one with coefficient +1 at
+     * '2 * row_pos' and the one with coefficient -1 at '2 * row_pos + 1'.
+     * Stored as 'nullptr' in 'solver_columns'.
+     */
+    std::vector<ColIdx> penalty_columns;
+
+    /**
+     * Columns of the dual-optimal inequalities of the model (see
+     * 'Model::dual_optimal_inequalities'), with their upper bounds, if
+     * any. Stored as 'nullptr' in 'solver_columns'.
+     */
+    std::vector<std::pair<ColIdx, Value>> dual_optimal_inequality_columns;
+
+    /**
+     * For each LP variable, whether it is an artificial column of the
+     * penalty stabilization or of a dual-optimal inequality (1), which
+     * unlike a dummy column doesn't make the relaxation infeasible.
+     * Shorter than 'solver_columns' when its last variables aren't
+     * artificial.
+     */
+    std::vector<int8_t> solver_columns_artificial;
+
+    /** Whether LP variable 'column_id' is an artificial column. */
+    bool is_artificial(ColIdx column_id) const
+    {
+        return column_id < (ColIdx)solver_columns_artificial.size()
+            && solver_columns_artificial[column_id] == 1;
+    }
+
+    /*
+     * What the LP was built for: it can only be reused by an attempt with
+     * exactly the same rows, row bounds and cuts.
+     */
+
+    SolverName solver_name = SolverName::CLP;
+    std::vector<RowIdx> new_rows;
+    std::vector<Value> new_row_lower_bounds;
+    std::vector<Value> new_row_upper_bounds;
+    std::vector<std::shared_ptr<const Cut>> active_cuts;
+    std::vector<Value> new_cut_lower_bounds;
+    std::vector<Value> new_cut_upper_bounds;
+};
+
+/**
+ * Approximate memory used by a master LP: its matrix, stored both row-wise
+ * and column-wise by the linear programming solvers, its bounds and
+ * objective coefficients, and the bookkeeping of 'ColumnGenerationMaster'.
+ * The coefficients of the cuts are not counted.
+ */
+Counter memory(const ColumnGenerationMaster& master)
+{
+    Counter number_of_nonzeros = 0;
+    for (const std::shared_ptr<const Column>& column: master.solver_columns)
+        number_of_nonzeros += (column == nullptr)? 1: column->elements.size();
+    Counter number_of_rows = master.new_rows.size() + master.active_cuts.size();
+    Counter number_of_columns = master.solver_columns.size();
+    return 2 * number_of_nonzeros * (sizeof(int) + sizeof(double))
+        + (number_of_rows + number_of_columns) * 4 * sizeof(double)
+        + master.solver_columns.capacity() * sizeof(std::shared_ptr<const Column>)
+        + master.solver_generated_columns.size() * (sizeof(std::shared_ptr<const Column>) + 2 * sizeof(void*))
+        + master.solver_columns_enabled.capacity() * sizeof(int8_t)
+        + master.solver_columns_artificial.capacity() * sizeof(int8_t);
+}
+
+}
+
+std::shared_ptr<ColumnGenerationMaster> columngenerationsolver::create_column_generation_master()
+{
+    return std::make_shared<ColumnGenerationMaster>();
+}
+
 namespace
 {
 
@@ -38,10 +139,67 @@ Value rounding_heuristic_infeasibility_contribution(
     return rounding_heuristic_violation(lower_bound, upper_bound, value) / violation_start;
 }
 
-using ColumnPool = std::unordered_set<
-    std::shared_ptr<const Column>,
-    const ColumnHasher&,
-    const ColumnHasher&>;
+/**
+ * View of the column pool for one 'column_generation()' call.
+ *
+ * The pool itself may be shared by all the nodes of a tree search, so it
+ * is never filtered or copied: a column infeasible given the fixed columns
+ * of this call (see 'is_feasible') is only skipped when scanned, and its
+ * feasibility is computed the first time it is needed.
+ */
+struct ColumnPoolView
+{
+    /** Constructor. */
+    ColumnPoolView(
+            const Model& model,
+            ColumnPool& column_pool,
+            const std::vector<Value>& row_values,
+            const std::vector<RowIdx>& new_row_indices):
+        model(model),
+        column_pool(column_pool),
+        row_values(row_values),
+        new_row_indices(new_row_indices) { }
+
+    /**
+     * Return 'true' iff a column of the pool may be added to the master
+     * LP: it doesn't contain a fixed row, and, if it is integer, doesn't
+     * exceed the upper bound of a row given the fixed columns. For example,
+     * it corresponds to the same bin / machine as a currently fixed column
+     * or it contains an item / job also included in a currently fixed
+     * column.
+     */
+    bool is_feasible(ColIdx column_id)
+    {
+        if (column_id >= (ColIdx)feasible.size())
+            feasible.resize(column_pool.number_of_columns(), -1);
+        if (feasible[column_id] == -1) {
+            const Column& column = *column_pool.column(column_id);
+            feasible[column_id] = 1;
+            for (const LinearTerm& element: column.elements) {
+                if (model.rows[element.row].coefficient_lower_bound >= 0
+                        && column.type == VariableType::Integer
+                        && row_values[element.row] + element.coefficient
+                        > model.rows[element.row].upper_bound) {
+                    feasible[column_id] = 0;
+                    break;
+                }
+                if (new_row_indices[element.row] < 0) {
+                    feasible[column_id] = 0;
+                    break;
+                }
+            }
+        }
+        return feasible[column_id];
+    }
+
+    const Model& model;
+    ColumnPool& column_pool;
+    const std::vector<Value>& row_values;
+    const std::vector<RowIdx>& new_row_indices;
+
+    /** Feasibility of the columns of the pool (-1: not computed yet). */
+    std::vector<int8_t> feasible;
+};
 
 /**
  * Input for 'run_column_generation_attempt()': one "build a master LP from
@@ -84,9 +242,16 @@ struct ColumnGenerationAttemptInput
      */
     Counter pricing_level;
 
+    /**
+     * Master LP to reuse, and to leave behind for the next attempt (the
+     * optimality phase only, see 'ColumnGenerationParameters::master').
+     * 'nullptr': build a throwaway one.
+     */
+    ColumnGenerationMaster* master;
+
     // Mutated across the whole 'column_generation()' call, not just this
     // one attempt.
-    ColumnPool& column_pool;
+    ColumnPoolView& column_pool;
     ColumnGenerationOutput& output;
     AlgorithmFormatter& algorithm_formatter;
 };
@@ -217,14 +382,17 @@ void rounding_heuristic_add_to_column_pool(
         RoundingHeuristicInput& input,
         const std::shared_ptr<const Column>& column)
 {
-    if (input.attempt_input.column_pool.find(column) != input.attempt_input.column_pool.end())
+    if (!input.attempt_input.column_pool.column_pool.add(column).second)
         return;
-    input.attempt_input.column_pool.insert(column);
     input.attempt_input.output.columns.push_back(column);
+    input.attempt_input.output.maximum_column_pool_size = (std::max)(
+            input.attempt_input.output.maximum_column_pool_size,
+            input.attempt_input.column_pool.column_pool.number_of_columns());
 }
 
 void run_rounding_heuristic(RoundingHeuristicInput& input)
 {
+    COLUMNGENERATIONSOLVER_TRACE_SCOPE("rounding_heuristic");
     auto start = std::chrono::high_resolution_clock::now();
 
     bool minimize = (input.attempt_input.model.objective_sense == optimizationtools::ObjectiveDirection::Minimize);
@@ -358,8 +526,16 @@ void run_rounding_heuristic(RoundingHeuristicInput& input)
                 // relaxation, not just for the rows still short after
                 // Phase 1's greedy fixing.
                 for (;;) {
-                    input.attempt_input.model.pricing_solver->initialize_pricing(fixed_columns, input.attempt_input.active_cuts, input.attempt_input.parameters.branching_decisions);
-                    auto pricing_output = input.attempt_input.model.pricing_solver->solve_pricing(false, input.duals_out, input.cut_duals, input.attempt_input.pricing_level);
+                    input.attempt_input.model.pricing_solver->initialize_pricing(fixed_columns, input.attempt_input.active_cuts, input.attempt_input.parameters.branching_decisions, input.attempt_input.parameters.reduced_cost_fixing_gap);
+                    input.attempt_input.model.pricing_solver->start_subproblem_generation();
+                    PricingContext pricing_context = PricingContext::create(input.attempt_input.parameters.timer);
+                    input.attempt_input.model.pricing_solver->update_pricing_context(false, input.duals_out, pricing_context);
+                    auto pricing_output = input.attempt_input.model.pricing_solver->solve_pricing(
+                            false,
+                            input.duals_out,
+                            input.cut_duals,
+                            input.attempt_input.pricing_level,
+                            pricing_context);
                     std::vector<std::shared_ptr<const Column>> new_columns;
                     for (const auto& column: pricing_output.columns) {
                         if (column->elements.empty())
@@ -401,7 +577,8 @@ void run_rounding_heuristic(RoundingHeuristicInput& input)
                 }
                 // Restore the real pricing solver state for the pricing
                 // calls in 'column_generation()'.
-                input.attempt_input.model.pricing_solver->initialize_pricing(input.attempt_input.parameters.fixed_columns, input.attempt_input.active_cuts, input.attempt_input.parameters.branching_decisions);
+                input.attempt_input.model.pricing_solver->initialize_pricing(input.attempt_input.parameters.fixed_columns, input.attempt_input.active_cuts, input.attempt_input.parameters.branching_decisions, input.attempt_input.parameters.reduced_cost_fixing_gap);
+                input.attempt_input.model.pricing_solver->start_subproblem_generation();
             }
 
             // Build and check the candidate solution. Always done (rather
@@ -427,74 +604,186 @@ void run_rounding_heuristic(RoundingHeuristicInput& input)
 }
 
 /**
- * Result of one 'run_column_generation_attempt()' call.
+ * Select at most 'maximum_number_of_columns' of 'columns' (all of them if
+ * -1), greedily by decreasing improvement (minus the reduced cost for a
+ * minimization problem), each one discounted by a factor
+ * '1 - diversity * overlap', where 'overlap' is the fraction of its rows
+ * already covered by the selected columns.
  */
-struct ColumnGenerationAttemptResult
+std::vector<std::shared_ptr<const Column>> select_columns(
+        const ColumnGenerationAttemptInput& input,
+        const std::vector<std::shared_ptr<const Column>>& columns,
+        const std::vector<Value>& duals,
+        const std::vector<std::pair<std::shared_ptr<const Cut>, Value>>& cut_duals,
+        Counter maximum_number_of_columns,
+        Value diversity)
 {
-    /**
-     * 'true' iff the relaxation this attempt converged to still needs
-     * dummy columns to be feasible. Under 'ColumnGenerationAttemptInput::
-     * solve_feasibility', a rigorous infeasibility proof (when the
-     * pricing solver's 'overcost' allows one) has already been reported
-     * through 'ColumnGenerationAttemptInput::algorithm_formatter' by the
-     * time this is 'true' -- the caller only needs this flag to decide
-     * whether to fall through to the optimality phase.
-     */
-    bool has_dummy_column = false;
+    if (maximum_number_of_columns == -1
+            || (Counter)columns.size() <= maximum_number_of_columns) {
+        return columns;
+    }
 
-    /**
-     * 'true' iff the timer or the iteration limit fired mid-attempt: the
-     * caller must stop immediately (finish up and return from
-     * 'column_generation()') rather than act on 'has_dummy_column' or
-     * retry.
-     */
-    bool stop_now = false;
-};
+    std::vector<Value> improvements(columns.size());
+    for (ColIdx pos = 0; pos < (ColIdx)columns.size(); ++pos) {
+        Value rc = input.model.compute_reduced_cost(input.solve_feasibility, *columns[pos], duals, cut_duals);
+        improvements[pos] = (input.model.objective_sense == optimizationtools::ObjectiveDirection::Minimize)? -rc: rc;
+    }
+
+    std::vector<ColIdx> positions(columns.size());
+    std::iota(positions.begin(), positions.end(), 0);
+    std::vector<std::shared_ptr<const Column>> selected_columns;
+    if (diversity == 0) {
+        std::partial_sort(
+                positions.begin(),
+                positions.begin() + maximum_number_of_columns,
+                positions.end(),
+                [&improvements](ColIdx pos_1, ColIdx pos_2)
+                {
+                    return improvements[pos_1] > improvements[pos_2];
+                });
+        for (Counter k = 0; k < maximum_number_of_columns; ++k)
+            selected_columns.push_back(columns[positions[k]]);
+        return selected_columns;
+    }
+
+    // 'positions' holds the candidates not selected yet, in no particular
+    // order: a selected one is swapped with the last one and popped. Ties
+    // are broken by position in 'columns'.
+    std::vector<uint8_t> covered(input.number_of_rows, 0);
+    while ((Counter)selected_columns.size() < maximum_number_of_columns) {
+        ColIdx best_candidate_id = -1;
+        Value best_score = -std::numeric_limits<Value>::infinity();
+        for (ColIdx candidate_id = 0;
+                candidate_id < (ColIdx)positions.size();
+                ++candidate_id) {
+            ColIdx pos = positions[candidate_id];
+            const Column& column = *columns[pos];
+            Value overlap = 0;
+            if (!column.elements.empty()) {
+                for (const LinearTerm& element: column.elements)
+                    overlap += covered[element.row];
+                overlap /= column.elements.size();
+            }
+            Value score = improvements[pos] * (1 - diversity * overlap);
+            if (best_candidate_id == -1
+                    || score > best_score
+                    || (score == best_score && pos < positions[best_candidate_id])) {
+                best_candidate_id = candidate_id;
+                best_score = score;
+            }
+        }
+        ColIdx best_pos = positions[best_candidate_id];
+        selected_columns.push_back(columns[best_pos]);
+        for (const LinearTerm& element: columns[best_pos]->elements)
+            covered[element.row] = 1;
+        positions[best_candidate_id] = positions.back();
+        positions.pop_back();
+    }
+    return selected_columns;
+}
 
 /**
- * Build a master LP from 'input.initial_columns' (plus static/fixed
- * columns and dummy columns for any row/cut fixed/initial columns alone
- * can't satisfy), run column generation on it to convergence, and report
- * whether the result still needs dummy columns. Extracted verbatim from
- * what the dummy-column retry loop in 'column_generation()' used to do
- * inline; the retry loop itself (the magnitude-based infeasibility check,
- * the escalate-and-retry logic) stays in 'column_generation()' and calls
- * this once per retry.
+ * Call the pricing solver for all the pricing levels from
+ * 'input.pricing_level' at once, each in its own thread (see
+ * 'ColumnGenerationParameters::concurrent_pricing_levels').
+ *
+ * Return the output of the first call which returns a column improving at
+ * 'duals', the other calls being cancelled, or, if none does, the output of
+ * the most thorough level, which provides the bound.
  */
-ColumnGenerationAttemptResult run_column_generation_attempt(
-        ColumnGenerationAttemptInput& input)
+PricingSolver::PricingOutput race_pricing_levels(
+        ColumnGenerationAttemptInput& input,
+        const std::vector<Value>& duals,
+        const std::vector<std::pair<std::shared_ptr<const Cut>, Value>>& cut_duals,
+        const PricingContext& context)
 {
-    ColumnGenerationAttemptResult result;
-
-    // Bound on the best possible reduced cost over the whole attempt, per
-    // the 3-way contract on 'PricingOutput::overcost' (exact /
-    // heuristic-no-bound / heuristic-with-a-bound). Stays at its
-    // sense-aware infinity default until the first pricing call sets it;
-    // from then on reflects the last pricing call's value. Used both to
-    // stream the tightest bound achievable each iteration (below) and, if
-    // 'input.solve_feasibility' and dummy columns persist once this
-    // attempt converges, to test for a rigorous infeasibility proof.
-    Value overcost = (input.model.objective_sense == optimizationtools::ObjectiveDirection::Minimize)?
-        -std::numeric_limits<Value>::infinity():
-        +std::numeric_limits<Value>::infinity();
+    Counter number_of_calls
+        = input.model.pricing_solver->number_of_pricing_levels()
+        - input.pricing_level;
+
+    std::atomic<bool> cancel(false);
+    PricingContext call_context = context;
+    call_context.cancel = &cancel;
+
+    std::mutex mutex;
+    std::condition_variable condition_variable;
+    std::vector<PricingSolver::PricingOutput> outputs(number_of_calls);
+    std::vector<std::exception_ptr> exceptions(number_of_calls);
+    Counter number_of_finished_calls = 0;
+    Counter winner = -1;
+
+    std::vector<std::thread> threads;
+    for (Counter call = 0; call < number_of_calls; ++call) {
+        threads.push_back(std::thread([&, call]()
+        {
+            COLUMNGENERATIONSOLVER_TRACE_SCOPE("pricing_level");
+            PricingSolver::PricingOutput output;
+            std::exception_ptr exception;
+            bool improving = false;
+            try {
+                output = input.model.pricing_solver->solve_pricing(
+                        input.solve_feasibility,
+                        duals,
+                        cut_duals,
+                        input.pricing_level + call,
+                        call_context);
+                for (const auto& column: output.columns) {
+                    Value rc = input.model.compute_reduced_cost(input.solve_feasibility, *column, duals, cut_duals);
+                    if ((input.model.objective_sense == optimizationtools::ObjectiveDirection::Minimize)?
+                            rc < -input.parameters.optimality_tolerance:
+                            rc > input.parameters.optimality_tolerance) {
+                        improving = true;
+                        break;
+                    }
+                }
+            } catch (...) {
+                exception = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            outputs[call] = std::move(output);
+            exceptions[call] = exception;
+            number_of_finished_calls++;
+            if (winner == -1 && improving)
+                winner = call;
+            condition_variable.notify_one();
+        }));
+    }
 
-    // Appends the coefficients of 'column' in the active cuts to 'ri'/'rc',
-    // at row indices following the model rows.
-    auto append_cut_coefficients = [&input](
-            const Column& column,
-            std::vector<RowIdx>& ri,
-            std::vector<Value>& rc)
+    // Wait for a winner, or for all the calls, then cancel the remaining
+    // ones.
+    Counter number_of_cancelled_calls = 0;
     {
-        for (CutIdx cut_pos = 0; cut_pos < (CutIdx)input.active_cuts.size(); ++cut_pos) {
-            Value coef = input.model.pricing_solver->coefficient(*input.active_cuts[cut_pos], column);
-            if (coef != 0.0) {
-                ri.push_back(input.new_number_of_rows + cut_pos);
-                rc.push_back(coef);
-            }
-        }
-    };
+        std::unique_lock<std::mutex> lock(mutex);
+        condition_variable.wait(
+                lock,
+                [&winner, &number_of_finished_calls, number_of_calls]()
+                {
+                    return winner != -1
+                        || number_of_finished_calls == number_of_calls;
+                });
+        number_of_cancelled_calls = number_of_calls - number_of_finished_calls;
+    }
+    cancel = true;
+    for (std::thread& thread: threads)
+        thread.join();
+    input.output.number_of_cancelled_pricings += number_of_cancelled_calls;
+
+    for (const std::exception_ptr& exception: exceptions)
+        if (exception != nullptr)
+            std::rethrow_exception(exception);
+    if (winner == -1)
+        return std::move(outputs.back());
+    return std::move(outputs[winner]);
+}
 
-    // Initialize solver
+/**
+ * Create an empty master LP (rows and cuts only) with the linear
+ * programming solver selected by 'input.parameters.solver_name'.
+ */
+std::unique_ptr<LinearProgrammingSolver> create_linear_programming_solver(
+        const ColumnGenerationAttemptInput& input)
+{
+    COLUMNGENERATIONSOLVER_TRACE_SCOPE("lp_build");
     //std::cout << "Initialize solver... " << input.parameters.solver_name << std::endl;
     std::vector<Value> lp_row_lower_bounds = input.new_row_lower_bounds;
     std::vector<Value> lp_row_upper_bounds = input.new_row_upper_bounds;
@@ -554,23 +843,160 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
     if (solver == NULL) {
         throw std::runtime_error("ERROR, no linear programming solver found");
     }
+    return solver;
+}
+
+/**
+ * Result of one 'run_column_generation_attempt()' call.
+ */
+struct ColumnGenerationAttemptResult
+{
+    /**
+     * 'true' iff the relaxation this attempt converged to still needs
+     * dummy columns to be feasible. Under 'ColumnGenerationAttemptInput::
+     * solve_feasibility', a rigorous infeasibility proof (when the
+     * pricing solver's 'overcost' allows one) has already been reported
+     * through 'ColumnGenerationAttemptInput::algorithm_formatter' by the
+     * time this is 'true' -- the caller only needs this flag to decide
+     * whether to fall through to the optimality phase.
+     */
+    bool has_dummy_column = false;
+
+    /**
+     * 'true' iff the timer or the iteration limit fired mid-attempt: the
+     * caller must stop immediately (finish up and return from
+     * 'column_generation()') rather than act on 'has_dummy_column' or
+     * retry.
+     */
+    bool stop_now = false;
+
+    /**
+     * 'true' iff the optimality phase has been stopped by the tailing-off
+     * criterion (see 'ColumnGenerationParameters::tailing_off').
+     */
+    bool tailing_off = false;
+
+    /**
+     * 'true' iff the last pricing call of the attempt raced all the pricing
+     * levels from 'ColumnGenerationAttemptInput::pricing_level' (see
+     * 'race_pricing_levels'), so that the most thorough level has already
+     * been called. Not the case under internal diving, which only calls
+     * the cheapest level.
+     */
+    bool raced = false;
+};
+
+/**
+ * Build a master LP from 'input.initial_columns' (plus static/fixed
+ * columns and dummy columns for any row/cut fixed/initial columns alone
+ * can't satisfy), run column generation on it to convergence, and report
+ * whether the result still needs dummy columns. Extracted verbatim from
+ * what the dummy-column retry loop in 'column_generation()' used to do
+ * inline; the retry loop itself (the magnitude-based infeasibility check,
+ * the escalate-and-retry logic) stays in 'column_generation()' and calls
+ * this once per retry.
+ *
+ * In the optimality phase, the master LP of a previous attempt is reused
+ * in place when it was built for the same rows and cuts (see
+ * 'ColumnGenerationAttemptInput::master').
+ */
+ColumnGenerationAttemptResult run_column_generation_attempt(
+        ColumnGenerationAttemptInput& input)
+{
+    ColumnGenerationAttemptResult result;
+
+    // Bound on the best possible reduced cost over the whole attempt, per
+    // the 3-way contract on 'PricingOutput::overcost' (exact /
+    // heuristic-no-bound / heuristic-with-a-bound). Stays at its
+    // sense-aware infinity default until the first pricing call sets it;
+    // from then on reflects the last pricing call's value. Used both to
+    // stream the tightest bound achievable each iteration (below) and, if
+    // 'input.solve_feasibility' and dummy columns persist once this
+    // attempt converges, to test for a rigorous infeasibility proof.
+    Value overcost = (input.model.objective_sense == optimizationtools::ObjectiveDirection::Minimize)?
+        -std::numeric_limits<Value>::infinity():
+        +std::numeric_limits<Value>::infinity();
+
+    // Appends the coefficients of 'column' in the active cuts to 'ri'/'rc',
+    // at row indices following the model rows.
+    auto append_cut_coefficients = [&input](
+            const Column& column,
+            std::vector<RowIdx>& ri,
+            std::vector<Value>& rc)
+    {
+        if (input.active_cuts.empty())
+            return;
+        auto start_cut_coefficients = std::chrono::high_resolution_clock::now();
+        for (CutIdx cut_pos = 0; cut_pos < (CutIdx)input.active_cuts.size(); ++cut_pos) {
+            Value coef = input.model.pricing_solver->coefficient(*input.active_cuts[cut_pos], column);
+            if (coef != 0.0) {
+                ri.push_back(input.new_number_of_rows + cut_pos);
+                rc.push_back(coef);
+            }
+        }
+        auto end_cut_coefficients = std::chrono::high_resolution_clock::now();
+        auto time_span_cut_coefficients = std::chrono::duration_cast<std::chrono::duration<double>>(end_cut_coefficients - start_cut_coefficients);
+        input.output.time_cut_coefficients += time_span_cut_coefficients.count();
+    };
+
+    // Initialize solver, or reuse the optimality-phase master LP of a
+    // previous attempt if it was built for exactly the same rows and cuts
+    // (see 'ColumnGenerationParameters::master').
+    auto start_master_construction = std::chrono::high_resolution_clock::now();
+    ColumnGenerationMaster attempt_master;
+    ColumnGenerationMaster& master = (input.master != nullptr)? *input.master: attempt_master;
+    bool reuse_master = (master.solver != nullptr
+            && master.solver_name == input.parameters.solver_name
+            && master.new_rows == input.new_rows
+            && master.new_row_lower_bounds == input.new_row_lower_bounds
+            && master.new_row_upper_bounds == input.new_row_upper_bounds
+            && master.active_cuts == input.active_cuts
+            && master.new_cut_lower_bounds == input.new_cut_lower_bounds
+            && master.new_cut_upper_bounds == input.new_cut_upper_bounds);
+    if (!reuse_master) {
+        master = ColumnGenerationMaster();
+        master.solver_name = input.parameters.solver_name;
+        master.new_rows = input.new_rows;
+        master.new_row_lower_bounds = input.new_row_lower_bounds;
+        master.new_row_upper_bounds = input.new_row_upper_bounds;
+        master.active_cuts = input.active_cuts;
+        master.new_cut_lower_bounds = input.new_cut_lower_bounds;
+        master.new_cut_upper_bounds = input.new_cut_upper_bounds;
+        master.solver = create_linear_programming_solver(input);
+        input.output.number_of_lp_rebuilds++;
+    }
+    std::unique_ptr<LinearProgrammingSolver>& solver = master.solver;
 
     // This array is used to retrieve the corresponding column from a
     // variable id in the LP solver solution.
-    std::vector<std::shared_ptr<const Column>> solver_columns;
+    std::vector<std::shared_ptr<const Column>>& solver_columns = master.solver_columns;
 
     // We never add a generated column more than once in the LP solver.
     // We use this set to keep track of the generated columns inside the
     // LP solver.
-    std::unordered_set<std::shared_ptr<const Column>> solver_generated_columns;
+    std::unordered_set<std::shared_ptr<const Column>>& solver_generated_columns = master.solver_generated_columns;
 
     input.output.number_of_columns_in_linear_subproblem = 0;
 
     // Initialize pricing solver.
     //std::cout << "Initialize pricing solver..." << std::endl;
+    auto start_initialize_pricing = std::chrono::high_resolution_clock::now();
     std::vector<std::shared_ptr<const Column>> infeasible_columns
-        = input.model.pricing_solver->initialize_pricing(input.parameters.fixed_columns, input.active_cuts, input.parameters.branching_decisions);
+        = input.model.pricing_solver->initialize_pricing(input.parameters.fixed_columns, input.active_cuts, input.parameters.branching_decisions, input.parameters.reduced_cost_fixing_gap);
+    input.model.pricing_solver->start_subproblem_generation();
+    auto end_initialize_pricing = std::chrono::high_resolution_clock::now();
     std::vector<int8_t> feasible(input.model.static_columns.size(), 1);
+    // Same columns, for the column pool scan below, which may visit every
+    // pooled column at each iteration: a pooled column which violates a
+    // branching decision must never make it back into the LP.
+    std::unordered_set<std::shared_ptr<const Column>> infeasible_column_set(
+            infeasible_columns.begin(),
+            infeasible_columns.end());
+
+    // Only set again once this attempt converges (see the end of the loop
+    // below).
+    input.output.duals.clear();
+    input.output.cut_duals.clear();
 
     // Add dummy columns. Phase 2 (optimality) has none at all: it is only
     // ever reached once Phase 1 has already found a dummy-free relaxation,
@@ -639,86 +1065,134 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
         }
     }
 
-    // Add input.model columns.
-    std::vector<Value> lower_bounds;
-    std::vector<Value> upper_bounds;
-    std::vector<Value> objective_coefficients;
-    std::vector<std::vector<RowIdx>> row_ids;
-    std::vector<std::vector<Value>> row_coefficients;
-    for (const std::shared_ptr<const Column>& column: input.model.static_columns) {
-        input.model.check_column(column);
-
-        // Don't add the column if it has already been fixed.
-        bool is_fixed = false;
-        for (const auto& p: input.parameters.fixed_columns)
-            if (p.first.get() == column.get())
-                is_fixed = true;
-        if (is_fixed)
-            continue;
-
-        // Check column feasibility.
-        if (std::find(infeasible_columns.begin(), infeasible_columns.end(), column)
-                != infeasible_columns.end())
-            continue;
-
-        std::vector<RowIdx> ri;
-        std::vector<Value> rc;
-        bool ok = true;
-        //bool print = false;
-        //for (const LinearTerm& element: column->elements)
-        //    if (element.row == 11380)
-        //        print = true;
-        for (const LinearTerm& element: column->elements) {
-            // The column might not be feasible.
-            // For example, it corresponds to the same bin / machine that a
-            // currently fixed column or it contains an item / job also
-            // included in a currently fixed column.
-            if (input.model.rows[element.row].coefficient_lower_bound >= 0
-                    && column->type == VariableType::Integer
-                    && input.row_values[element.row] + element.coefficient
-                    > input.model.rows[element.row].upper_bound) {
-                //if (print) {
-                //    std::cout << "element " << element.row
-                //        << " " << element.coefficient
-                //        << std::endl;
-                //}
+    // Reused LP: disable the columns which have become infeasible, and
+    // re-enable the ones which are feasible again. The rows and their
+    // bounds are unchanged, so only the column-specific exclusions need
+    // checking again. Static columns are the ones not in
+    // 'solver_generated_columns'.
+    if (reuse_master) {
+        master.solver_columns_enabled.resize(solver_columns.size(), 1);
+        for (ColIdx column_id = 0;
+                column_id < (ColIdx)solver_columns.size();
+                ++column_id) {
+            const std::shared_ptr<const Column>& column = solver_columns[column_id];
+            if (column == nullptr)
+                continue;
+            bool generated = (solver_generated_columns.find(column) != solver_generated_columns.end());
+            bool ok = (infeasible_column_set.find(column) == infeasible_column_set.end());
+            if (ok && generated
+                    && input.parameters.tabu != nullptr
+                    && input.parameters.tabu->find(column) != input.parameters.tabu->end()) {
                 ok = false;
-                break;
             }
-            if (input.new_row_indices[element.row] < 0) {
-                ok = false;
-                break;
+            if (ok && !generated) {
+                for (const auto& p: input.parameters.fixed_columns)
+                    if (p.first.get() == column.get())
+                        ok = false;
+            }
+            if (ok != (master.solver_columns_enabled[column_id] == 1)) {
+                if (!ok) {
+                    solver->set_column_bounds(column_id, 0, 0);
+                    input.output.number_of_columns_removed++;
+                } else if (generated) {
+                    solver->set_column_bounds(column_id, 0, std::numeric_limits<Value>::infinity());
+                } else {
+                    solver->set_column_bounds(column_id, column->lower_bound, column->upper_bound);
+                }
+                master.solver_columns_enabled[column_id] = (ok)? 1: 0;
             }
-            ri.push_back(input.new_row_indices[element.row]);
-            rc.push_back(element.coefficient);
+            if (ok)
+                input.output.number_of_columns_in_linear_subproblem++;
         }
-        //if (print) {
-        //    std::cout << *column << std::endl;
-        //    std::cout << "ok " << ok << std::endl;
-        //}
-        if (!ok)
-            continue;
-        append_cut_coefficients(*column, ri, rc);
-        solver_columns.push_back(column);
-        lower_bounds.push_back(column->lower_bound);
-        upper_bounds.push_back(column->upper_bound);
-        objective_coefficients.push_back(
-                input.solve_feasibility? 0: column->objective_coefficient);
-        row_ids.push_back(ri);
-        row_coefficients.push_back(rc);
-        input.output.number_of_columns_in_linear_subproblem++;
     }
-    solver->add_columns(
-            row_ids,
-            row_coefficients,
-            objective_coefficients,
-            lower_bounds,
-            upper_bounds);
+
+    // Add input.model columns (already there in a reused LP).
+    if (!reuse_master) {
+        std::vector<Value> lower_bounds;
+        std::vector<Value> upper_bounds;
+        std::vector<Value> objective_coefficients;
+        std::vector<std::vector<RowIdx>> row_ids;
+        std::vector<std::vector<Value>> row_coefficients;
+        for (const std::shared_ptr<const Column>& column: input.model.static_columns) {
+            input.model.check_column(column);
+
+            // Don't add the column if it has already been fixed.
+            bool is_fixed = false;
+            for (const auto& p: input.parameters.fixed_columns)
+                if (p.first.get() == column.get())
+                    is_fixed = true;
+            if (is_fixed)
+                continue;
+
+            // Check column feasibility.
+            if (std::find(infeasible_columns.begin(), infeasible_columns.end(), column)
+                    != infeasible_columns.end())
+                continue;
+
+            std::vector<RowIdx> ri;
+            std::vector<Value> rc;
+            bool ok = true;
+            //bool print = false;
+            //for (const LinearTerm& element: column->elements)
+            //    if (element.row == 11380)
+            //        print = true;
+            for (const LinearTerm& element: column->elements) {
+                // The column might not be feasible.
+                // For example, it corresponds to the same bin / machine that a
+                // currently fixed column or it contains an item / job also
+                // included in a currently fixed column.
+                if (input.model.rows[element.row].coefficient_lower_bound >= 0
+                        && column->type == VariableType::Integer
+                        && input.row_values[element.row] + element.coefficient
+                        > input.model.rows[element.row].upper_bound) {
+                    //if (print) {
+                    //    std::cout << "element " << element.row
+                    //        << " " << element.coefficient
+                    //        << std::endl;
+                    //}
+                    ok = false;
+                    break;
+                }
+                if (input.new_row_indices[element.row] < 0) {
+                    ok = false;
+                    break;
+                }
+                ri.push_back(input.new_row_indices[element.row]);
+                rc.push_back(element.coefficient);
+            }
+            //if (print) {
+            //    std::cout << *column << std::endl;
+            //    std::cout << "ok " << ok << std::endl;
+            //}
+            if (!ok)
+                continue;
+            append_cut_coefficients(*column, ri, rc);
+            solver_columns.push_back(column);
+            lower_bounds.push_back(column->lower_bound);
+            upper_bounds.push_back(column->upper_bound);
+            objective_coefficients.push_back(
+                    input.solve_feasibility? 0: column->objective_coefficient);
+            row_ids.push_back(ri);
+            row_coefficients.push_back(rc);
+            input.output.number_of_columns_in_linear_subproblem++;
+            input.output.number_of_columns_added++;
+        }
+        solver->add_columns(
+                row_ids,
+                row_coefficients,
+                objective_coefficients,
+                lower_bounds,
+                upper_bounds);
+    }
 
     // Add initial columns.
     for (const std::shared_ptr<const Column>& column: input.initial_columns) {
         input.model.check_generated_column(column);
 
+        // Already in a reused LP, and handled above.
+        if (solver_generated_columns.find(column) != solver_generated_columns.end())
+            continue;
+
         // Check column feasibility.
         if (std::find(infeasible_columns.begin(), infeasible_columns.end(), column)
                 != infeasible_columns.end())
@@ -763,6 +1237,7 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
                 0,
                 std::numeric_limits<Value>::infinity());
         input.output.number_of_columns_in_linear_subproblem++;
+        input.output.number_of_columns_added++;
     }
 
     // Duals given to the pricing solver.
@@ -771,12 +1246,7 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
     std::vector<Value> duals_in(input.number_of_rows, 0);
     // π_out, duals of next point without stabilization.
     std::vector<Value> duals_out(input.number_of_rows, 0);
-    // π_in + (1 − α) (π_out − π_in)
-    std::vector<Value> duals_tilde(input.number_of_rows, 0);
-    // Duals in the direction of the subgradient.
-    std::vector<Value> duals_g(input.number_of_rows, 0);
-    // β π_g + (1 − β) π_out
-    std::vector<Value> rho(input.number_of_rows, 0);
+    SeparationPointWorkspace separation_point_workspace;
     std::vector<Value> lagrangian_constraint_values(input.number_of_rows, 0);
     // g_in.
     std::vector<Value> subgradient(input.number_of_rows, 0);
@@ -791,6 +1261,196 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
         cut_duals.push_back({cut, 0.0});
     double alpha = input.parameters.static_wentges_smoothing_parameter;
 
+    // In the optimality phase, start from the stability center and alpha
+    // left by the previous optimality phase (or given by the caller). The
+    // feasibility phase has a different objective, so its duals don't say
+    // anything about those of the optimality phase.
+    if (!input.solve_feasibility) {
+        if (!input.output.stability_center.empty())
+            for (RowIdx row_id: input.new_rows)
+                duals_sep[row_id] = input.output.stability_center[row_id];
+        if (input.parameters.self_adjusting_wentges_smoothing
+                && input.output.wentges_smoothing_parameter >= 0) {
+            alpha = input.output.wentges_smoothing_parameter;
+        }
+    }
+
+    // Penalty stabilization: the artificial columns are only set up in the
+    // optimality phase, with the stability center of the smoothing as
+    // initial center. In a reused LP, they already exist, and are only
+    // disabled if this attempt doesn't use them.
+    bool penalty_stabilization = (!input.solve_feasibility
+            && input.parameters.penalty_stabilization
+            && input.parameters.penalty_stabilization_initial_penalty > 0);
+    Value penalty = input.parameters.penalty_stabilization_initial_penalty;
+    std::vector<Value> penalty_center = duals_sep;
+    auto update_penalty_columns = [&input, &solver, &master, &penalty, &penalty_center]()
+    {
+        Value delta = input.parameters.penalty_stabilization_box_half_width;
+        bool minimize = (input.model.objective_sense == optimizationtools::ObjectiveDirection::Minimize);
+        for (RowIdx row_pos = 0; row_pos < input.new_number_of_rows; ++row_pos) {
+            Value center = penalty_center[input.new_rows[row_pos]];
+            ColIdx column_id_plus = master.penalty_columns[2 * row_pos];
+            ColIdx column_id_minus = master.penalty_columns[2 * row_pos + 1];
+            solver->set_objective_coefficient(
+                    column_id_plus,
+                    (minimize)? center + delta: center - delta);
+            solver->set_objective_coefficient(
+                    column_id_minus,
+                    (minimize)? -(center - delta): -(center + delta));
+            solver->set_column_bounds(column_id_plus, 0, penalty);
+            solver->set_column_bounds(column_id_minus, 0, penalty);
+        }
+    };
+    if (penalty_stabilization) {
+        if (master.penalty_columns.empty()) {
+            for (RowIdx row_pos = 0; row_pos < input.new_number_of_rows; ++row_pos) {
+                for (Value coefficient: {+1.0, -1.0}) {
+                    master.penalty_columns.push_back(solver_columns.size());
+                    master.solver_columns_artificial.resize(solver_columns.size() + 1, 0);
+                    master.solver_columns_artificial.back() = 1;
+                    solver_columns.push_back(nullptr);
+                    solver->add_column({row_pos}, {coefficient}, 0, 0, 0);
+                }
+            }
+        }
+        update_penalty_columns();
+    } else {
+        for (ColIdx column_id: master.penalty_columns)
+            solver->set_column_bounds(column_id, 0, 0);
+    }
+
+    // Dual-optimal inequalities: optimality phase only, like the penalty
+    // stabilization. An inequality involving a row which has been removed
+    // (satisfied by the fixed columns) is skipped.
+    bool dual_optimal_inequalities = (!input.solve_feasibility
+            && input.parameters.dual_optimal_inequalities
+            && !input.model.dual_optimal_inequalities.empty());
+    if (dual_optimal_inequalities) {
+        if (master.dual_optimal_inequality_columns.empty()) {
+            for (const std::shared_ptr<const Column>& column: input.model.dual_optimal_inequalities) {
+                input.model.check_column(column);
+                std::vector<RowIdx> row_ids;
+                std::vector<Value> row_coefficients;
+                bool ok = true;
+                for (const LinearTerm& element: column->elements) {
+                    if (input.new_row_indices[element.row] < 0) {
+                        ok = false;
+                        break;
+                    }
+                    row_ids.push_back(input.new_row_indices[element.row]);
+                    row_coefficients.push_back(element.coefficient);
+                }
+                if (!ok)
+                    continue;
+                master.dual_optimal_inequality_columns.push_back({solver_columns.size(), column->upper_bound});
+                master.solver_columns_artificial.resize(solver_columns.size() + 1, 0);
+                master.solver_columns_artificial.back() = 1;
+                solver_columns.push_back(nullptr);
+                solver->add_column(
+                        row_ids,
+                        row_coefficients,
+                        column->objective_coefficient,
+                        0,
+                        column->upper_bound);
+            }
+        } else {
+            for (const auto& p: master.dual_optimal_inequality_columns)
+                solver->set_column_bounds(p.first, 0, p.second);
+        }
+        dual_optimal_inequalities = !master.dual_optimal_inequality_columns.empty();
+    } else {
+        for (const auto& p: master.dual_optimal_inequality_columns)
+            solver->set_column_bounds(p.first, 0, 0);
+    }
+
+    auto end_master_construction = std::chrono::high_resolution_clock::now();
+    auto time_span_master_construction = std::chrono::duration_cast<std::chrono::duration<double>>(
+            (end_master_construction - start_master_construction)
+            - (end_initialize_pricing - start_initialize_pricing));
+    input.output.time_master_construction += time_span_master_construction.count();
+
+    // Interior point: optimality phase only, until the simplex takes over.
+    bool interior_point = (!input.solve_feasibility
+            && input.parameters.interior_point);
+    bool interior_point_solved = false;
+    Value interior_point_tolerance = input.parameters.interior_point_maximum_tolerance;
+
+    // Value of the Lagrangian function at 'duals' and 'cut_duals', given
+    // the 'overcost' of the pricing solver at these duals. Unlike the value
+    // of the LP plus 'overcost', it is a valid bound whatever the duals,
+    // and so doesn't require an exact LP solve. Only the real columns are
+    // involved: the generated ones through 'overcost', the static ones in
+    // the LP one by one.
+    auto compute_lagrangian_bound = [&input, &master, &solver_columns, &solver_generated_columns](
+            const std::vector<Value>& duals,
+            const std::vector<std::pair<std::shared_ptr<const Cut>, Value>>& cut_duals,
+            Value overcost)
+    {
+        bool minimize = (input.model.objective_sense == optimizationtools::ObjectiveDirection::Minimize);
+        Value bound = input.c0 + overcost;
+        auto add = [&bound, minimize](Value coefficient, Value lower_bound, Value upper_bound)
+        {
+            if (coefficient == 0)
+                return;
+            bound += coefficient * (((coefficient > 0) == minimize)? lower_bound: upper_bound);
+        };
+        for (RowIdx row_pos = 0; row_pos < input.new_number_of_rows; ++row_pos) {
+            add(duals[input.new_rows[row_pos]],
+                    input.new_row_lower_bounds[row_pos],
+                    input.new_row_upper_bounds[row_pos]);
+        }
+        for (CutIdx cut_pos = 0; cut_pos < (CutIdx)input.active_cuts.size(); ++cut_pos) {
+            add(cut_duals[cut_pos].second,
+                    input.new_cut_lower_bounds[cut_pos],
+                    input.new_cut_upper_bounds[cut_pos]);
+        }
+        for (ColIdx column_id = 0;
+                column_id < (ColIdx)solver_columns.size();
+                ++column_id) {
+            const std::shared_ptr<const Column>& column = solver_columns[column_id];
+            if (column == nullptr
+                    || solver_generated_columns.find(column) != solver_generated_columns.end())
+                continue;
+            if (column_id < (ColIdx)master.solver_columns_enabled.size()
+                    && master.solver_columns_enabled[column_id] == 0)
+                continue;
+            add(input.model.compute_reduced_cost(false, *column, duals, cut_duals),
+                    column->lower_bound,
+                    column->upper_bound);
+        }
+        return bound;
+    };
+
+    // Time budget of the pricing calls, grown when they get interrupted.
+    double pricing_time_budget = input.parameters.pricing_time_budget;
+
+    // Whether the pricing levels are raced rather than escalated.
+    bool concurrent_pricing_levels = input.parameters.concurrent_pricing_levels
+        && input.model.pricing_solver->supports_concurrent_pricing_levels()
+        && input.model.pricing_solver->number_of_pricing_levels() - input.pricing_level > 1;
+
+    // Maximum number of columns added to the LP per iteration. When
+    // adaptive, it starts at the number of rows if not capped.
+    Counter maximum_number_of_new_columns = input.parameters.maximum_number_of_columns_per_iteration;
+    if (input.parameters.adaptive_number_of_columns_per_iteration
+            && maximum_number_of_new_columns == -1) {
+        maximum_number_of_new_columns = (std::max)((RowIdx)1, input.new_number_of_rows);
+    }
+    // Time of the last LP solve and of the last pricing, for the adaptive
+    // maximum number of columns.
+    double time_last_lpsolve = 0.0;
+    double time_last_pricing = 0.0;
+
+    // Value of the relaxation solution at each iteration of the optimality
+    // phase, for the tailing-off criterion.
+    std::vector<Value> relaxation_solution_values;
+
+    // Best bound found at a separation point during this attempt.
+    Value penalty_best_bound = (input.model.objective_sense == optimizationtools::ObjectiveDirection::Minimize)?
+        -std::numeric_limits<Value>::infinity():
+        +std::numeric_limits<Value>::infinity();
+
     RoundingHeuristicInput rounding_heuristic_input{
             input,
             solver.get(),
@@ -815,12 +1475,34 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
             ++number_of_column_generation_iterations) {
         //std::cout << "number_of_column_generation_iterations " << number_of_column_generation_iterations << std::endl;
 
+        // Statistics of the iteration (see 'iteration_trace_writer').
+        ColumnGenerationIterationRecord iteration_record;
+
         // Solve LP
         auto start_lpsolve = std::chrono::high_resolution_clock::now();
-        solver->solve();
+        bool interior_point_solve = interior_point;
+        if (interior_point_solve) {
+            COLUMNGENERATIONSOLVER_TRACE_SCOPE("lp_solve_interior_point");
+            solver->solve_interior_point(interior_point_tolerance);
+            input.output.number_of_interior_point_solves++;
+        } else {
+            COLUMNGENERATIONSOLVER_TRACE_SCOPE("lp_solve");
+            solver->solve();
+            // First simplex solve: the current 'overcost' has been computed
+            // at duals which aren't optimal for the LP.
+            if (interior_point_solved) {
+                interior_point_solved = false;
+                overcost = (input.model.objective_sense == optimizationtools::ObjectiveDirection::Minimize)?
+                    -std::numeric_limits<Value>::infinity():
+                    +std::numeric_limits<Value>::infinity();
+            }
+        }
+        interior_point_solved = interior_point_solve;
         auto end_lpsolve = std::chrono::high_resolution_clock::now();
         auto time_span_lpsolve = std::chrono::duration_cast<std::chrono::duration<double>>(end_lpsolve - start_lpsolve);
         input.output.time_lpsolve += time_span_lpsolve.count();
+        time_last_lpsolve = time_span_lpsolve.count();
+        iteration_record.time_lpsolve = time_span_lpsolve.count();
         input.output.relaxation_solution_value = input.c0 + solver->objective();
 
         // The bound and the per-iteration display are computed after
@@ -852,6 +1534,7 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
                     column_id < (ColIdx)solver_columns.size();
                     ++column_id) {
                 if (solver_columns[column_id] == nullptr
+                        && !master.is_artificial(column_id)
                         && std::abs(solver->primal(column_id)) >= FFOT_TOL) {
                     has_dummy_column_now = true;
                     break;
@@ -869,6 +1552,30 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
             cut_duals[cut_pos].second = solver->dual(input.new_number_of_rows + cut_pos);
         }
 
+        // Whether the duals are outside the box of the penalty
+        // stabilization, i.e. the LP solution uses artificial columns.
+        bool penalty_columns_used = false;
+        if (penalty_stabilization && penalty > 0) {
+            for (ColIdx column_id: master.penalty_columns) {
+                if (solver->primal(column_id) >= FFOT_TOL) {
+                    penalty_columns_used = true;
+                    break;
+                }
+            }
+        }
+
+        // Whether the LP solution uses dual-optimal inequalities, i.e. isn't
+        // a solution of the original master.
+        bool dual_optimal_inequalities_used = false;
+        if (dual_optimal_inequalities) {
+            for (const auto& p: master.dual_optimal_inequality_columns) {
+                if (solver->primal(p.first) >= FFOT_TOL) {
+                    dual_optimal_inequalities_used = true;
+                    break;
+                }
+            }
+        }
+
         if (!input.solve_feasibility
                 && input.parameters.rounding_heuristic
                 && pricing_called_previous_iteration) {
@@ -879,29 +1586,46 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
         std::vector<Value> pricing_lagrangian_column_values;
 
         // Search for new columns from the column pool.
-        for (const std::shared_ptr<const Column>& column: input.column_pool) {
-
-            // Don't add a column which is already in the LP.
-            if (solver_generated_columns.find(column) != solver_generated_columns.end())
-                continue;
-
-            // Don't add a tabu column.
-            if (input.parameters.tabu != nullptr
-                    && input.parameters.tabu->find(column) != input.parameters.tabu->end())
-                continue;
-
-            // Add the column if its reduced cost is negative.
-            Value rc = input.model.compute_reduced_cost(input.solve_feasibility, *column, duals_out, cut_duals);
-            if (input.model.objective_sense == optimizationtools::ObjectiveDirection::Minimize
-                    && rc < -input.parameters.optimality_tolerance) {
-                new_columns.push_back(column);
-            }
-            if (input.model.objective_sense == optimizationtools::ObjectiveDirection::Maximize
-                    && rc > input.parameters.optimality_tolerance) {
-                new_columns.push_back(column);
-            }
-
-        }
+        auto start_column_pool_scan = std::chrono::high_resolution_clock::now();
+        scan_column_pool(
+                input.model,
+                input.column_pool.column_pool,
+                input.solve_feasibility,
+                duals_out,
+                cut_duals,
+                input.parameters.optimality_tolerance,
+                [&input, &solver_generated_columns, &infeasible_column_set](
+                    ColIdx column_id,
+                    const std::shared_ptr<const Column>& column)
+                {
+                    // Don't add a column infeasible for the fixed columns.
+                    if (!input.column_pool.is_feasible(column_id))
+                        return false;
+
+                    // Don't add a column which is already in the LP.
+                    if (solver_generated_columns.find(column) != solver_generated_columns.end())
+                        return false;
+
+                    // Don't add a tabu column.
+                    if (input.parameters.tabu != nullptr
+                            && input.parameters.tabu->find(column) != input.parameters.tabu->end())
+                        return false;
+
+                    // Don't add a column infeasible for the current
+                    // branching decisions.
+                    if (!infeasible_column_set.empty()
+                            && infeasible_column_set.find(column) != infeasible_column_set.end())
+                        return false;
+
+                    return true;
+                },
+                new_columns);
+
+        auto end_column_pool_scan = std::chrono::high_resolution_clock::now();
+        iteration_record.time_column_pool_scan = std::chrono::duration_cast<std::chrono::duration<double>>(
+                end_column_pool_scan - start_column_pool_scan).count();
+        input.output.time_column_pool_scan += iteration_record.time_column_pool_scan;
+        iteration_record.number_of_column_pool_hits = new_columns.size();
 
         // Record, for the *next* iteration's rounding heuristic gate above,
         // whether real pricing is about to be called this iteration.
@@ -911,126 +1635,45 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
             // Search for new columns by solving the pricing problem.
 
             duals_in = duals_sep; // The last shall be the first.
+            time_last_pricing = 0.0;
             //std::cout << "alpha " << alpha << std::endl;
             for (Counter k = 1; ; ++k) {
                 // Mispricing number.
 
                 // Update global mispricing number.
-                if (k > 1)
+                if (k > 1) {
                     input.output.number_of_mispricings++;
+                    iteration_record.number_of_mispricings++;
+                }
 
                 // Compute separation point.
+                auto start_stabilization = std::chrono::high_resolution_clock::now();
                 double alpha_cur = std::max(0.0, 1 - k * (1 - alpha) - FFOT_TOL);
-                double beta = input.parameters.static_directional_smoothing_parameter;
-                //std::cout << "alpha_cur " << alpha_cur << std::endl;
-                if (number_of_column_generation_iterations == 1
+                bool directional_smoothing = !(
+                        number_of_column_generation_iterations == 1
                         || norm(input.new_rows, subgradient) == 0
                         // Shouldn't happen, but happens with Cplex.
                         || norm(input.new_rows, duals_in, duals_out) == 0
                         || k > 1
                         // No directional smoothing.
-                        || (!input.parameters.automatic_directional_smoothing && beta == 0)) {
-
-                    //std::cout << "compute duals_sep..." << std::endl;
-                    for (RowIdx row_id: input.new_rows) {
-                        //std::cout << " row " << row_id
-                        //    << " dual_in " << duals_in[row_id]
-                        //    << " dual_out " << duals_out[row_id]
-                        //    << " alpha " << alpha_cur
-                        //    << " dual_sep " << duals_sep[row_id]
-                        //    << std::endl;
-                        duals_sep[row_id]
-                            = alpha_cur * duals_in[row_id]
-                            + (1 - alpha_cur) * duals_out[row_id];
-                    }
-
-                } else {
-                    // Directional smoothing.
-
-                    // Compute π_tilde.
-                    for (RowIdx row_id: input.new_rows) {
-                        duals_tilde[row_id]
-                            = alpha_cur * duals_in[row_id]
-                            + (1 - alpha_cur) * duals_out[row_id];
-                    }
-
-                    // Compute π_g.
-                    //std::cout << "compute duals_g..." << std::endl;
-                    Value coef_g
-                        = norm(input.new_rows, duals_in, duals_out)
-                        / norm(input.new_rows, subgradient);
-                    for (RowIdx row_id: input.new_rows) {
-                        duals_g[row_id]
-                            = duals_in[row_id]
-                            + coef_g * subgradient[row_id];
-                        //std::cout << " row " << row_id
-                        //    << " dual_in " << duals_in[row_id]
-                        //    << " subgradient " << subgradient[row_id]
-                        //    << " coef_g " << coef_g
-                        //    << " dual_g " << duals_g[row_id]
-                        //    << std::endl;
-                    }
-
-                    // Compute β.
-                    if (input.parameters.automatic_directional_smoothing) {
-                        Value dot_product = 0;
-                        for (RowIdx row_id: input.new_rows) {
-                            dot_product
-                                += (duals_out[row_id] - duals_in[row_id])
-                                * (duals_g[row_id] - duals_in[row_id]);
-                        }
-                        beta = dot_product
-                            / norm(input.new_rows, duals_in, duals_out)
-                            / norm(input.new_rows, duals_in, duals_g);
-                        //std::cout << "beta " << beta << std::endl;
-                        //assert(beta >= 0);
-                        beta = std::max(0.0, std::min(1.0, beta));
-                    }
-
-                    // Compute ρ.
-                    //std::cout << "compute rho..." << std::endl;
-                    for (RowIdx row_id: input.new_rows) {
-                        rho[row_id]
-                            = beta * duals_g[row_id]
-                            + (1 - beta) * duals_out[row_id];
-                        //std::cout << " row " << row_id
-                        //    << " beta " << beta
-                        //    << " dual_g " << duals_g[row_id]
-                        //    << " dual_out " << duals_out[row_id]
-                        //    << " rho " << rho[row_id]
-                        //    << std::endl;
-                    }
-
-                    // Compute π_sep.
-                    //std::cout << "compute duals_sep..." << std::endl;
-                    //std::cout << "norm(input.new_rows, duals_in, duals_tilde) " << norm(input.new_rows, duals_in, duals_tilde) << std::endl;
-                    //std::cout << "norm(input.new_rows, duals_in, rho) " << norm(input.new_rows, duals_in, rho) << std::endl;
-                    Value norm_rho = norm(input.new_rows, duals_in, rho);
-                    if (norm_rho < FFOT_TOL) {
-                        // ρ ≈ π_in: directional adjustment is undefined;
-                        // fall back to plain Wentges smoothing.
-                        for (RowIdx row_id: input.new_rows)
-                            duals_sep[row_id] = duals_tilde[row_id];
-                    } else {
-                        Value coef_sep
-                            = norm(input.new_rows, duals_in, duals_tilde)
-                            / norm_rho;
-                        for (RowIdx row_id: input.new_rows) {
-                            //std::cout << " row " << row_id
-                            //    << " dual_in " << duals_in[row_id]
-                            //    << " coef_sep " << coef_sep
-                            //    << " rho " << rho[row_id]
-                            //    << " dual_sep " << duals_sep[row_id]
-                            //    << std::endl;
-                            duals_sep[row_id]
-                                = duals_in[row_id]
-                                + coef_sep * (rho[row_id] - duals_in[row_id]);
-                        }
-                    }
-                }
+                        || (!input.parameters.automatic_directional_smoothing
+                            && input.parameters.static_directional_smoothing_parameter == 0));
+                double beta = compute_separation_point(
+                        input.new_rows,
+                        duals_in,
+                        duals_out,
+                        subgradient,
+                        alpha_cur,
+                        directional_smoothing,
+                        input.parameters.automatic_directional_smoothing,
+                        input.parameters.static_directional_smoothing_parameter,
+                        separation_point_workspace,
+                        duals_sep);
 
                 // Call pricing solver on the computed separation point.
                 auto start_pricing = std::chrono::high_resolution_clock::now();
+                auto time_span_stabilization = std::chrono::duration_cast<std::chrono::duration<double>>(start_pricing - start_stabilization);
+                input.output.time_stabilization += time_span_stabilization.count();
 
                 std::vector<std::shared_ptr<const Column>> all_columns;
                 // Internal diving calls the pricing solver repeatedly
@@ -1040,18 +1683,60 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
                 // more expensive) one. Fall back to a single plain
                 // pricing call per iteration whenever pricing_level > 0.
                 if (!input.parameters.internal_diving || input.pricing_level > 0) {
-                    auto pricing_output = input.model.pricing_solver->solve_pricing(input.solve_feasibility, duals_sep, cut_duals, input.pricing_level);
+                    COLUMNGENERATIONSOLVER_TRACE_SCOPE("pricing");
+                    // Retry with a larger time budget while the pricing
+                    // solver gets interrupted without finding any column,
+                    // which mostly happens close to convergence.
+                    PricingSolver::PricingOutput pricing_output;
+                    for (;;) {
+                        PricingContext pricing_context = PricingContext::create(input.parameters.timer, pricing_time_budget);
+                        input.model.pricing_solver->update_pricing_context(input.solve_feasibility, duals_sep, pricing_context);
+                        result.raced = concurrent_pricing_levels;
+                        if (concurrent_pricing_levels) {
+                            pricing_output = race_pricing_levels(
+                                    input,
+                                    duals_sep,
+                                    cut_duals,
+                                    pricing_context);
+                        } else {
+                            pricing_output = input.model.pricing_solver->solve_pricing(
+                                    input.solve_feasibility,
+                                    duals_sep,
+                                    cut_duals,
+                                    input.pricing_level,
+                                    pricing_context);
+                        }
+                        if (!pricing_output.interrupted)
+                            break;
+                        input.output.number_of_interrupted_pricings++;
+                        if (!pricing_output.columns.empty()
+                                || pricing_time_budget < 0
+                                || input.parameters.timer.needs_to_end()) {
+                            break;
+                        }
+                        pricing_time_budget *= input.parameters.pricing_time_budget_growth_factor;
+                    }
                     all_columns = pricing_output.columns;
                     overcost = pricing_output.overcost;
                     pricing_lagrangian_column_values = std::move(pricing_output.lagrangian_column_values);
                     for (const auto& column: all_columns)
                         input.model.check_generated_column(column);
                 } else {
+                    COLUMNGENERATIONSOLVER_TRACE_SCOPE("pricing_internal_diving");
+                    result.raced = false;
                     std::vector<Value> row_values_tmp = input.row_values;
                     std::vector<std::pair<std::shared_ptr<const Column>, Value>> fixed_columns_tmp = input.parameters.fixed_columns;
                     for (int i = 0;; ++i) {
-                        input.model.pricing_solver->initialize_pricing(fixed_columns_tmp, input.active_cuts, input.parameters.branching_decisions);
-                        auto pricing_output = input.model.pricing_solver->solve_pricing(input.solve_feasibility, duals_sep, cut_duals, input.pricing_level);
+                        input.model.pricing_solver->initialize_pricing(fixed_columns_tmp, input.active_cuts, input.parameters.branching_decisions, input.parameters.reduced_cost_fixing_gap);
+                        input.model.pricing_solver->start_subproblem_generation();
+                        PricingContext pricing_context = PricingContext::create(input.parameters.timer, pricing_time_budget);
+                        input.model.pricing_solver->update_pricing_context(input.solve_feasibility, duals_sep, pricing_context);
+                        auto pricing_output = input.model.pricing_solver->solve_pricing(
+                                input.solve_feasibility,
+                                duals_sep,
+                                cut_duals,
+                                input.pricing_level,
+                                pricing_context);
                         std::vector<std::shared_ptr<const Column>> all_columns_tmp_0
                             = pricing_output.columns;
                         if (i == 0) {
@@ -1121,12 +1806,18 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
                         if (!has_fixed)
                             break;
                     }
-                    input.model.pricing_solver->initialize_pricing(input.parameters.fixed_columns, input.active_cuts, input.parameters.branching_decisions);
+                    input.model.pricing_solver->initialize_pricing(input.parameters.fixed_columns, input.active_cuts, input.parameters.branching_decisions, input.parameters.reduced_cost_fixing_gap);
+                    input.model.pricing_solver->start_subproblem_generation();
                 }
 
                 auto end_pricing = std::chrono::high_resolution_clock::now();
                 auto time_span_pricing = std::chrono::duration_cast<std::chrono::duration<double>>(end_pricing - start_pricing);
                 input.output.time_pricing += time_span_pricing.count();
+                time_last_pricing += time_span_pricing.count();
+                iteration_record.time_pricing += time_span_pricing.count();
+                iteration_record.number_of_priced_columns += all_columns.size();
+                iteration_record.alpha = alpha_cur;
+                iteration_record.beta = beta;
                 input.output.number_of_pricings++;
                 if (alpha_cur == 0 && beta == 0)
                     input.output.number_of_no_stab_pricings++;
@@ -1134,15 +1825,15 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
                 // Look for negative reduced cost columns.
                 for (const std::shared_ptr<const Column>& column: all_columns) {
 
-                    // Discard columns which have already been generated.
+                    // Discard columns which have already been generated,
+                    // store the others in the pool.
                     // If they were worth adding to the LP, then they would
                     // have been added at the previous step (looking for
                     // column from the pool).
-                    if (input.column_pool.find(column) != input.column_pool.end())
+                    if (!input.column_pool.column_pool.add(column).second)
                         continue;
 
                     // Store these new columns.
-                    input.column_pool.insert(column);
                   input.output.columns.push_back(column);
 
                   // Only add the ones with negative reduced cost.
@@ -1155,6 +1846,9 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
                           && rc > input.parameters.optimality_tolerance)
                     new_columns.push_back(column);
                 }
+                input.output.maximum_column_pool_size = (std::max)(
+                        input.output.maximum_column_pool_size,
+                        input.column_pool.column_pool.number_of_columns());
 
                 if (!new_columns.empty() || (alpha_cur == 0.0 && beta == 0.0)) {
                     if (k == 1)
@@ -1166,7 +1860,16 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
 
         }
 
-        if (overcost != std::numeric_limits<Value>::infinity()) {
+        // Under penalty stabilization, the value of the penalized LP may
+        // increase from one iteration to the next (when the penalty
+        // decreases), so 'overcost' is only used if it has just been
+        // computed.
+        // Same with an interior point solve, whose value isn't the one of
+        // the Lagrangian function at its duals.
+        bool overcost_is_current = ((!penalty_stabilization && !interior_point_solve)
+                || pricing_called_previous_iteration);
+        if (overcost != std::numeric_limits<Value>::infinity()
+                && overcost_is_current) {
             if (!input.solve_feasibility) {
                 // Update bound, now that 'overcost' reflects a reduced cost
                 // computed at the same duals ('duals_out') as
@@ -1175,8 +1878,25 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
                 // solve, rather than the previous iteration's (still valid,
                 // since 'relaxation_solution_value' only improves across
                 // iterations, but needlessly loose).
-                Value bound = input.output.relaxation_solution_value + overcost;
+                Value bound = (!interior_point_solve)?
+                    input.output.relaxation_solution_value + overcost:
+                    compute_lagrangian_bound(duals_sep, cut_duals, overcost);
                 input.algorithm_formatter.update_bound(bound);
+
+                // Penalty stabilization: move the center to the separation
+                // point whenever it improves the bound. The penalized LP
+                // is a relaxation of the master, so the bound stays valid.
+                if (penalty_stabilization
+                        && penalty > 0
+                        && ((input.model.objective_sense == optimizationtools::ObjectiveDirection::Minimize)?
+                            bound > penalty_best_bound + FFOT_TOL:
+                            bound < penalty_best_bound - FFOT_TOL)) {
+                    penalty_best_bound = bound;
+                    for (RowIdx row_id: input.new_rows)
+                        penalty_center[row_id] = duals_sep[row_id];
+                    update_penalty_columns();
+                    input.output.number_of_stability_center_updates++;
+                }
             } else {
                 // Feasibility phase: 'relaxation_solution_value' (= 'input.c0'
                 // plus the LP's own objective) is *not* a valid bound on the
@@ -1210,11 +1930,45 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
                 }
             }
         }
+        // Interior point: tie the tolerance of the next solve to the gap,
+        // and hand over to the simplex once it gets small.
+        if (interior_point) {
+            Value relative_gap = std::abs(input.output.relaxation_solution_value - input.output.bound)
+                / (std::max)(1.0, std::abs(input.output.relaxation_solution_value));
+            if (std::isfinite(relative_gap)) {
+                interior_point_tolerance = (std::min)(
+                        input.parameters.interior_point_maximum_tolerance,
+                        relative_gap / input.parameters.interior_point_gap_factor);
+            }
+            if (interior_point_tolerance < input.parameters.interior_point_minimum_tolerance)
+                interior_point = false;
+        }
+
         input.algorithm_formatter.print_column_generation_iteration(
                 input.output.number_of_column_generation_iterations,
                 input.output.number_of_columns_in_linear_subproblem,
                 input.output.relaxation_solution_value,
                 input.output.bound);
+        input.output.memory_usage.column_pool = input.column_pool.column_pool.memory();
+        input.output.memory_usage.columns = input.output.columns.capacity() * sizeof(std::shared_ptr<const Column>);
+        input.output.memory_usage.master_lp = memory(master);
+        input.algorithm_formatter.update_memory_usage();
+        if (input.parameters.iteration_trace_writer != nullptr) {
+            iteration_record.node_id = input.parameters.node_id;
+            iteration_record.cutting_plane_iteration = input.output.number_of_cutting_plane_iterations;
+            iteration_record.solve_feasibility = input.solve_feasibility;
+            iteration_record.iteration = number_of_column_generation_iterations;
+            iteration_record.time = input.output.time;
+            iteration_record.number_of_improving_columns = new_columns.size();
+            Value dual_squared_norm = 0.0;
+            for (RowIdx row_id: input.new_rows)
+                dual_squared_norm += duals_out[row_id] * duals_out[row_id];
+            iteration_record.dual_norm = std::sqrt(dual_squared_norm);
+            iteration_record.number_of_columns_in_linear_subproblem = input.output.number_of_columns_in_linear_subproblem;
+            iteration_record.relaxation_solution_value = input.output.relaxation_solution_value;
+            iteration_record.bound = input.output.bound;
+            input.parameters.iteration_trace_writer->write(iteration_record);
+        }
         input.parameters.iteration_callback(input.output);
 
         // Stop as soon as nothing further this attempt could find would
@@ -1227,13 +1981,102 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
         if (input.output.optimal())
             break;
 
+        // Tailing off. Not while the LP solution uses artificial columns of
+        // the penalty stabilization or dual-optimal inequalities: it isn't
+        // a solution of the relaxation. Nor while it is only approximate.
+        if (!input.solve_feasibility) {
+            const TailingOffParameters& tailing_off = input.parameters.tailing_off;
+            Value value = input.output.relaxation_solution_value;
+            relaxation_solution_values.push_back(value);
+            bool stop = false;
+            if (tailing_off.window_size > 0
+                    && (Counter)relaxation_solution_values.size() > tailing_off.window_size) {
+                Value previous_value = relaxation_solution_values[
+                    relaxation_solution_values.size() - 1 - tailing_off.window_size];
+                Value relative_improvement = std::abs(previous_value - value)
+                    / (std::max)(1.0, std::abs(value));
+                if (relative_improvement < tailing_off.minimum_relative_improvement)
+                    stop = true;
+            }
+            if (tailing_off.maximum_relative_gap >= 0
+                    && std::isfinite(input.output.bound)) {
+                Value relative_gap = std::abs(value - input.output.bound)
+                    / (std::max)(1.0, std::abs(value));
+                if (relative_gap <= tailing_off.maximum_relative_gap)
+                    stop = true;
+            }
+            if (stop
+                    && !new_columns.empty()
+                    && !penalty_columns_used
+                    && !dual_optimal_inequalities_used
+                    && !interior_point_solve) {
+                result.tailing_off = true;
+                break;
+            }
+        }
+
         // Stop the column generation procedure if no negative reduced cost
         // column has been found.
         //std::cout << "new_columns.size() " << new_columns.size() << std::endl;
-        if (new_columns.empty())
+        if (new_columns.empty()) {
+            // Interior point: converged up to the tolerance only. Finish
+            // with the simplex, from the current columns.
+            if (interior_point_solve) {
+                interior_point = false;
+                continue;
+            }
+
+            // Penalty stabilization: converged for the penalized master
+            // only. Move the center to the current duals and decrease the
+            // penalty.
+            if (penalty_columns_used) {
+                for (RowIdx row_id: input.new_rows)
+                    penalty_center[row_id] = duals_out[row_id];
+                penalty *= input.parameters.penalty_stabilization_penalty_decrease_factor;
+                if (penalty < 1e-6 * input.parameters.penalty_stabilization_initial_penalty)
+                    penalty = 0;
+                update_penalty_columns();
+                input.output.number_of_stability_center_updates++;
+                input.output.number_of_penalty_updates++;
+                continue;
+            }
+
+            // Dual-optimal inequalities: the duals are optimal, but the LP
+            // solution still relies on them. Remove them and go on from
+            // the current columns to recover a solution of the master.
+            // The value of the LP increases, so the current 'overcost'
+            // must not be combined with it.
+            if (dual_optimal_inequalities_used) {
+                for (const auto& p: master.dual_optimal_inequality_columns)
+                    solver->set_column_bounds(p.first, 0, 0);
+                overcost = (input.model.objective_sense == optimizationtools::ObjectiveDirection::Minimize)?
+                    -std::numeric_limits<Value>::infinity():
+                    +std::numeric_limits<Value>::infinity();
+                dual_optimal_inequalities = false;
+                input.output.number_of_dual_optimal_inequality_removals++;
+                continue;
+            }
+
+            // Converged: the last pricing call was made at 'duals_out'
+            // itself (the mispricing loop above only stops without a new
+            // column once all smoothing is off), so 'overcost' is the one
+            // at these duals.
+            if (!input.solve_feasibility) {
+                input.output.duals = duals_out;
+                input.output.cut_duals = cut_duals;
+                if (overcost != std::numeric_limits<Value>::infinity()) {
+                    input.output.duals_bound = input.output.relaxation_solution_value + overcost;
+                } else {
+                    input.output.duals_bound = (input.model.objective_sense == optimizationtools::ObjectiveDirection::Minimize)?
+                        -std::numeric_limits<Value>::infinity():
+                        +std::numeric_limits<Value>::infinity();
+                }
+            }
             break;
+        }
 
         // Get Lagrangian constraint values Σ_k A·z*_k for the subgradient.
+        auto start_stabilization = std::chrono::high_resolution_clock::now();
         // Use the pricer-provided values when available — necessary for
         // identical subproblems (e.g. bin packing with N bins) where the
         // pricer sets lagrangian_column_values[row] = N * A[row, z*],
@@ -1305,6 +2148,38 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
                 alpha = std::min(0.99, alpha + (1.0 - alpha) * 0.1);
             }
         }
+        auto end_stabilization = std::chrono::high_resolution_clock::now();
+        auto time_span_stabilization = std::chrono::duration_cast<std::chrono::duration<double>>(end_stabilization - start_stabilization);
+        input.output.time_stabilization += time_span_stabilization.count();
+
+        // Select the columns to add to the linear program; the others stay
+        // in the column pool. All of them have been used for the
+        // subgradient above. When pricing is expensive compared to the LP
+        // solves, add more columns per pricing call; when the LP is the
+        // bottleneck, add fewer.
+        if (input.parameters.adaptive_number_of_columns_per_iteration
+                && pricing_called_previous_iteration) {
+            if (time_last_pricing > time_last_lpsolve) {
+                maximum_number_of_new_columns = maximum_number_of_new_columns
+                    + (std::max)((Counter)1, maximum_number_of_new_columns / 4);
+            } else {
+                maximum_number_of_new_columns = (std::max)(
+                        (Counter)1,
+                        maximum_number_of_new_columns * 4 / 5);
+            }
+            if (input.parameters.maximum_number_of_columns_per_iteration != -1) {
+                maximum_number_of_new_columns = (std::min)(
+                        maximum_number_of_new_columns,
+                        input.parameters.maximum_number_of_columns_per_iteration);
+            }
+        }
+        new_columns = select_columns(
+                input,
+                new_columns,
+                duals_out,
+                cut_duals,
+                maximum_number_of_new_columns,
+                input.parameters.column_selection_diversity);
 
         // Add new columns to the linear program.
         for (const std::shared_ptr<const Column>& column: new_columns) {
@@ -1333,10 +2208,48 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
                     0,
                     std::numeric_limits<double>::infinity());
             input.output.number_of_columns_in_linear_subproblem++;
+            input.output.number_of_columns_added++;
+        }
+    }
+
+    if (!input.solve_feasibility) {
+        input.output.stability_center = duals_sep;
+        input.output.wentges_smoothing_parameter = alpha;
+    }
+
+    // The loop may have been left (bound reached, time limit, iteration
+    // limit) while the LP solution still uses artificial columns of the
+    // penalty stabilization or of the dual-optimal inequalities, in which
+    // case it isn't a solution of the relaxation. Disable them and solve
+    // again from the current columns. The next attempts reusing the LP
+    // enable them again.
+    bool artificial_columns_used = false;
+    for (ColIdx column_id = 0;
+            column_id < (ColIdx)master.solver_columns_artificial.size();
+            ++column_id) {
+        if (master.is_artificial(column_id)
+                && std::abs(solver->primal(column_id)) >= FFOT_TOL) {
+            artificial_columns_used = true;
+            break;
+        }
+    }
+    if (artificial_columns_used) {
+        for (ColIdx column_id = 0;
+                column_id < (ColIdx)master.solver_columns_artificial.size();
+                ++column_id) {
+            if (master.is_artificial(column_id))
+                solver->set_column_bounds(column_id, 0, 0);
         }
+        auto start_lpsolve = std::chrono::high_resolution_clock::now();
+        solver->solve();
+        auto end_lpsolve = std::chrono::high_resolution_clock::now();
+        auto time_span_lpsolve = std::chrono::duration_cast<std::chrono::duration<double>>(end_lpsolve - start_lpsolve);
+        input.output.time_lpsolve += time_span_lpsolve.count();
+        input.output.relaxation_solution_value = input.c0 + solver->objective();
     }
 
     // Compute relaxation solution.
+    auto start_solution_building = std::chrono::high_resolution_clock::now();
     SolutionBuilder solution_builder;
     solution_builder.set_model(input.model);
     for (const auto& p: input.parameters.fixed_columns) {
@@ -1350,6 +2263,8 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
             ++column_id) {
         if (std::abs(solver->primal(column_id)) < FFOT_TOL)
             continue;
+        if (master.is_artificial(column_id))
+            continue;
         if (solver_columns[column_id] == nullptr) {
             has_dummy_column = true;
             //RowIdx row_orig_id = input.new_rows[dummy_column_rows[column_id]];
@@ -1373,10 +2288,14 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
                     solver->primal(column_id));
         }
     }
+    Solution relaxation_solution = solution_builder.build();
+    auto end_solution_building = std::chrono::high_resolution_clock::now();
+    auto time_span_solution_building = std::chrono::duration_cast<std::chrono::duration<double>>(end_solution_building - start_solution_building);
+    input.output.time_solution_building += time_span_solution_building.count();
 
     // Check time.
     if (input.parameters.timer.needs_to_end()) {
-        input.output.relaxation_solution = solution_builder.build();
+        input.output.relaxation_solution = relaxation_solution;
         result.stop_now = true;
         return result;
     }
@@ -1384,7 +2303,7 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
     if (input.parameters.maximum_number_of_iterations != -1
             && input.output.number_of_column_generation_iterations
             > input.parameters.maximum_number_of_iterations) {
-        input.output.relaxation_solution = solution_builder.build();
+        input.output.relaxation_solution = relaxation_solution;
         result.stop_now = true;
         return result;
     }
@@ -1401,7 +2320,6 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
     // '!has_dummy_column' uniformly in both phases: Phase 2 never has
     // dummy columns in its LP at all, so 'has_dummy_column' is always
     // 'false' there by construction.
-    Solution relaxation_solution = solution_builder.build();
     input.output.relaxation_solution = relaxation_solution;
     input.output.relaxation_solution_is_feasible = !has_dummy_column;
 
@@ -1422,10 +2340,98 @@ ColumnGenerationAttemptResult run_column_generation_attempt(
 
 }
 
+Value columngenerationsolver::compute_separation_point(
+        const std::vector<RowIdx>& new_rows,
+        const std::vector<Value>& duals_in,
+        const std::vector<Value>& duals_out,
+        const std::vector<Value>& subgradient,
+        Value alpha,
+        bool directional_smoothing,
+        bool automatic_directional_smoothing,
+        Value beta,
+        SeparationPointWorkspace& workspace,
+        std::vector<Value>& duals_sep)
+{
+    if (!directional_smoothing) {
+        for (RowIdx row_id: new_rows) {
+            duals_sep[row_id]
+                = alpha * duals_in[row_id]
+                + (1 - alpha) * duals_out[row_id];
+        }
+        return beta;
+    }
+
+    std::vector<Value>& duals_tilde = workspace.duals_tilde;
+    std::vector<Value>& duals_g = workspace.duals_g;
+    std::vector<Value>& rho = workspace.rho;
+    duals_tilde.resize(duals_in.size(), 0);
+    duals_g.resize(duals_in.size(), 0);
+    rho.resize(duals_in.size(), 0);
+
+    // Compute π_tilde.
+    for (RowIdx row_id: new_rows) {
+        duals_tilde[row_id]
+            = alpha * duals_in[row_id]
+            + (1 - alpha) * duals_out[row_id];
+    }
+
+    // Compute π_g.
+    Value coef_g
+        = norm(new_rows, duals_in, duals_out)
+        / norm(new_rows, subgradient);
+    for (RowIdx row_id: new_rows) {
+        duals_g[row_id]
+            = duals_in[row_id]
+            + coef_g * subgradient[row_id];
+    }
+
+    // Compute β.
+    if (automatic_directional_smoothing) {
+        Value dot_product = 0;
+        for (RowIdx row_id: new_rows) {
+            dot_product
+                += (duals_out[row_id] - duals_in[row_id])
+                * (duals_g[row_id] - duals_in[row_id]);
+        }
+        beta = dot_product
+            / norm(new_rows, duals_in, duals_out)
+            / norm(new_rows, duals_in, duals_g);
+        beta = std::max(0.0, std::min(1.0, beta));
+    }
+
+    // Compute ρ.
+    for (RowIdx row_id: new_rows) {
+        rho[row_id]
+            = beta * duals_g[row_id]
+            + (1 - beta) * duals_out[row_id];
+    }
+
+    // Compute π_sep.
+    Value norm_rho = norm(new_rows, duals_in, rho);
+    if (norm_rho < FFOT_TOL) {
+        // ρ ≈ π_in: directional adjustment is undefined; fall back to
+        // plain Wentges smoothing.
+        for (RowIdx row_id: new_rows)
+            duals_sep[row_id] = duals_tilde[row_id];
+    } else {
+        Value coef_sep
+            = norm(new_rows, duals_in, duals_tilde)
+            / norm_rho;
+        for (RowIdx row_id: new_rows) {
+            duals_sep[row_id]
+                = duals_in[row_id]
+                + coef_sep * (rho[row_id] - duals_in[row_id]);
+        }
+    }
+    return beta;
+}
+
 const ColumnGenerationOutput columngenerationsolver::column_generation(
         const Model& model,
         const ColumnGenerationParameters& parameters)
 {
+    COLUMNGENERATIONSOLVER_TRACE_SCOPE("column_generation");
+
     // Initial display.
     ColumnGenerationOutput output(model);
     AlgorithmFormatter algorithm_formatter(
@@ -1437,21 +2443,57 @@ const ColumnGenerationOutput columngenerationsolver::column_generation(
 
     RowIdx number_of_rows = model.rows.size();
     //std::cout << "m " << m << std::endl;
+
+    // Warm stability center, updated by each optimality phase for the
+    // next one.
+    if (!parameters.initial_stability_center.empty()
+            && (RowIdx)parameters.initial_stability_center.size() != number_of_rows) {
+        throw std::invalid_argument(
+                "columngenerationsolver::column_generation: "
+                "'initial_stability_center' must be empty or contain one "
+                "value per row.");
+    }
+    if (parameters.penalty_stabilization
+            && (parameters.penalty_stabilization_penalty_decrease_factor < 0
+                || parameters.penalty_stabilization_penalty_decrease_factor >= 1)) {
+        throw std::invalid_argument(
+                "columngenerationsolver::column_generation: "
+                "'penalty_stabilization_penalty_decrease_factor' must be "
+                "in [0, 1).");
+    }
+    if (parameters.pricing_time_budget >= 0
+            && parameters.pricing_time_budget_growth_factor <= 1) {
+        throw std::invalid_argument(
+                "columngenerationsolver::column_generation: "
+                "'pricing_time_budget_growth_factor' must be greater "
+                "than 1.");
+    }
+    output.stability_center = parameters.initial_stability_center;
+    output.wentges_smoothing_parameter = parameters.initial_wentges_smoothing_parameter;
     //std::cout << "parameters.fixed_columns.size() " << parameters.fixed_columns.size() << std::endl;
 
     // Compute row values.
     //std::cout << "Compute row values..." << std::endl;
-    std::vector<Value> row_values(number_of_rows, 0.0);
+    // Unless the caller already maintains them.
+    std::vector<Value> call_row_values;
     Value c0 = 0.0;
-    for (auto p: parameters.fixed_columns) {
-        //std::cout << *p.first << std::endl;
-        //std::cout << p.second << std::endl;
-        const Column& column = *(p.first);
-        Value value = p.second;
-        for (const LinearTerm& element: column.elements)
-            row_values[element.row] += value * element.coefficient;
-        c0 += value * column.objective_coefficient;
+    if (parameters.fixed_columns_contribution != nullptr) {
+        c0 = parameters.fixed_columns_contribution->objective_value;
+    } else {
+        call_row_values.resize(number_of_rows, 0.0);
+        for (auto p: parameters.fixed_columns) {
+            //std::cout << *p.first << std::endl;
+            //std::cout << p.second << std::endl;
+            const Column& column = *(p.first);
+            Value value = p.second;
+            for (const LinearTerm& element: column.elements)
+                call_row_values[element.row] += value * element.coefficient;
+            c0 += value * column.objective_coefficient;
+        }
     }
+    const std::vector<Value>& row_values = (parameters.fixed_columns_contribution != nullptr)?
+        parameters.fixed_columns_contribution->row_values:
+        call_row_values;
 
     // Compute fixed rows.
     //std::cout << "Compute fixed rows..." << std::endl;
@@ -1508,37 +2550,20 @@ const ColumnGenerationOutput columngenerationsolver::column_generation(
 
     // We never keep a generated column identical to a previously generated
     // column.
-    // This set is used to store all the generated column.
-    ColumnHasher column_hasher(model);
-    std::unordered_set<std::shared_ptr<const Column>,
-                       const ColumnHasher&,
-                       const ColumnHasher&> column_pool(0, column_hasher, column_hasher);
-    // We first add to it the columns from the input column pool.
-    for (const auto& column: parameters.column_pool) {
-
-        bool ok = true;
-        for (const LinearTerm& element: column->elements) {
-            // The column might not be feasible.
-            // For example, it corresponds to the same bin / machine that a
-            // currently fixed column or it contains an item / job also
-            // included in a currently fixed column.
-            if (model.rows[element.row].coefficient_lower_bound >= 0
-                    && column->type == VariableType::Integer
-                    && row_values[element.row] + element.coefficient
-                    > model.rows[element.row].upper_bound) {
-                ok = false;
-                break;
-            }
-            if (new_row_indices[element.row] < 0) {
-                ok = false;
-                break;
-            }
-        }
-        if (!ok)
-            continue;
-
-        column_pool.insert(column);
-    }
+    // The pool is used to store all the generated column. It starts with
+    // the columns from the input column pool, unless the caller shares its
+    // own.
+    std::unique_ptr<ColumnPool> call_column_pool;
+    if (parameters.shared_column_pool == nullptr)
+        call_column_pool.reset(new ColumnPool(model, parameters.column_pool));
+    ColumnPoolView column_pool(
+            model,
+            (parameters.shared_column_pool != nullptr)?
+                *parameters.shared_column_pool:
+                *call_column_pool,
+            row_values,
+            new_row_indices);
+    output.maximum_column_pool_size = column_pool.column_pool.number_of_columns();
 
     // Active cuts. Starts from 'initial_cuts' and grows as cutting-plane
     // rounds find violated cuts below.
@@ -1571,6 +2596,14 @@ const ColumnGenerationOutput columngenerationsolver::column_generation(
     // cheapest level is always retried first.
     Counter pricing_level = 0;
 
+    // Optimality-phase master LP, reused across attempts (and across calls
+    // if the caller provides one) as long as the rows and cuts don't
+    // change.
+    ColumnGenerationMaster call_master;
+    ColumnGenerationMaster* master = (parameters.master != nullptr)?
+        parameters.master.get():
+        &call_master;
+
     // Loop for cutting planes.
     // After the dummy-column loop below converges to a feasible relaxation
     // (no dummy column left), if cutting planes are enabled, cuts are
@@ -1593,6 +2626,7 @@ const ColumnGenerationOutput columngenerationsolver::column_generation(
         // fixed columns (mirrors the row residual-bound computation above).
         std::vector<Value> new_cut_lower_bounds(active_cuts.size());
         std::vector<Value> new_cut_upper_bounds(active_cuts.size());
+        auto start_cut_coefficients = std::chrono::high_resolution_clock::now();
         for (CutIdx cut_pos = 0; cut_pos < (CutIdx)active_cuts.size(); ++cut_pos) {
             Value cut_fixed_value = 0.0;
             for (const auto& p: parameters.fixed_columns)
@@ -1600,6 +2634,9 @@ const ColumnGenerationOutput columngenerationsolver::column_generation(
             new_cut_lower_bounds[cut_pos] = active_cuts[cut_pos]->lower_bound - cut_fixed_value;
             new_cut_upper_bounds[cut_pos] = active_cuts[cut_pos]->upper_bound - cut_fixed_value;
         }
+        auto end_cut_coefficients = std::chrono::high_resolution_clock::now();
+        auto time_span_cut_coefficients = std::chrono::duration_cast<std::chrono::duration<double>>(end_cut_coefficients - start_cut_coefficients);
+        output.time_cut_coefficients += time_span_cut_coefficients.count();
 
         // Appends the coefficients of 'column' in the active cuts to 'ri'/'rc',
         // at row indices following the model rows.
@@ -1624,6 +2661,9 @@ const ColumnGenerationOutput columngenerationsolver::column_generation(
         // columns at all. Phase 2 is only reached once Phase 1 has actually
         // converged dummy-free, so its relaxation is guaranteed feasible by
         // construction.
+        // 'raced': whether the last pricing call of the last attempt raced
+        // the remaining pricing levels.
+        bool raced = false;
         for (bool solve_feasibility : {true, false}) {
 
             algorithm_formatter.print_column_generation_phase_header(solve_feasibility);
@@ -1646,6 +2686,7 @@ const ColumnGenerationOutput columngenerationsolver::column_generation(
                     initial_columns,
                     solve_feasibility,
                     pricing_level,
+                    (solve_feasibility)? nullptr: master,
                     column_pool,
                     output,
                     algorithm_formatter};
@@ -1657,6 +2698,9 @@ const ColumnGenerationOutput columngenerationsolver::column_generation(
                 algorithm_formatter.end();
                 return output;
             }
+            if (attempt_result.tailing_off)
+                output.tailing_off = true;
+            raced = attempt_result.raced;
 
             // Warm-start columns for whichever attempt runs next (the other
             // phase; another cutting-plane round; an escalated pricing level)
@@ -1667,7 +2711,7 @@ const ColumnGenerationOutput columngenerationsolver::column_generation(
             // 'run_column_generation_attempt'.
             initial_columns = parameters.initial_columns;
             for (const auto& p: output.relaxation_solution.columns())
-                if (column_pool.find(p.first) != column_pool.end())
+                if (column_pool.column_pool.contains(p.first))
                     initial_columns.push_back(p.first);
 
             if (solve_feasibility) {
@@ -1707,21 +2751,34 @@ const ColumnGenerationOutput columngenerationsolver::column_generation(
         if (output.optimal())
             break;
 
+        // Stopped by the tailing-off criterion: the relaxation is good
+        // enough, don't separate cuts or escalate the pricing level.
+        if (output.tailing_off)
+            break;
+
+        // Whether a more thorough pricing level remains to be called. If the
+        // last pricing call raced the pricing levels, the most thorough level
+        // has already been called.
+        bool escalate = pricing_level < model.pricing_solver->number_of_pricing_levels() - 1
+            && !raced;
+
         // Cutting planes disabled for this call, or the iteration limit already
-        // reached: if the relaxation is genuinely feasible (Phase 2 succeeded),
-        // stop here, exactly like before cuts existed. If it's still only
-        // inconclusive (Phase 1 failed but wasn't proven infeasible), pricing-
-        // level escalation below is an independent knob, unrelated to cutting
+        // reached: if the relaxation is genuinely feasible (Phase 2 succeeded)
+        // and the most thorough pricing level has been called, stop here,
+        // exactly like before cuts existed. Otherwise, pricing-level
+        // escalation below is an independent knob, unrelated to cutting
         // planes, and still worth a try.
         bool try_cutting_planes = parameters.cutting_planes
             && (parameters.maximum_number_of_cutting_plane_iterations == -1
                     || cutting_plane_iteration < parameters.maximum_number_of_cutting_plane_iterations);
-        if (!try_cutting_planes && output.relaxation_solution_is_feasible)
+        if (!try_cutting_planes && output.relaxation_solution_is_feasible && !escalate)
             break;
 
         std::vector<std::shared_ptr<const Cut>> new_cuts;
         bool removed_a_cut = false;
         if (try_cutting_planes) {
+            COLUMNGENERATIONSOLVER_TRACE_SCOPE("cut_separation");
+            auto start_cut_separation = std::chrono::high_resolution_clock::now();
             // Separate cuts from the current relaxation solution -- the full
             // feasible one from Phase 2, or, if Phase 1 stayed inconclusive
             // instead, the partial one it left behind (dummy columns excluded
@@ -1811,6 +2868,9 @@ const ColumnGenerationOutput columngenerationsolver::column_generation(
                 }
             }
             active_cuts = std::move(still_active_cuts);
+            auto end_cut_separation = std::chrono::high_resolution_clock::now();
+            auto time_span_cut_separation = std::chrono::duration_cast<std::chrono::duration<double>>(end_cut_separation - start_cut_separation);
+            output.time_cut_separation += time_span_cut_separation.count();
         }
 
         if (new_cuts.empty() && !removed_a_cut) {
@@ -1821,7 +2881,7 @@ const ColumnGenerationOutput columngenerationsolver::column_generation(
             // stronger pricing level might still find a column or a cut that a
             // cheaper one couldn't. Only truly done once every level has
             // already been tried.
-            if (pricing_level < model.pricing_solver->number_of_pricing_levels() - 1) {
+            if (escalate) {
                 ++pricing_level;
             } else {
                 break;
@@ -1836,9 +2896,10 @@ const ColumnGenerationOutput columngenerationsolver::column_generation(
             output.number_of_cutting_plane_iterations++;
         }
 
-        // Rebuild the master LP from scratch next round (with the enlarged cut
-        // set, if any -- unchanged otherwise, if this round only escalated the
-        // pricing level): 'initial_columns' is already warm-started from this
+        // Rebuild the master LP from scratch next round if the cut set
+        // changed; if this round only escalated the pricing level, the
+        // optimality phase reuses its LP in place instead (see 'master').
+        // Either way, 'initial_columns' is already warm-started from this
         // attempt's own relaxation solution, set right after it ran, above.
     }
 
@@ -2,12 +2,15 @@
 
 #include "columngenerationsolver/algorithm_formatter.hpp"
 
+#include "trace_events.hpp"
+
 using namespace columngenerationsolver;
 
 const GreedyOutput columngenerationsolver::greedy(
         const Model& model,
         const GreedyParameters& parameters)
 {
+    COLUMNGENERATIONSOLVER_TRACE_SCOPE("greedy");
     // Initial display.
     GreedyOutput output(model);
     AlgorithmFormatter algorithm_formatter(
@@ -16,12 +19,17 @@ const GreedyOutput columngenerationsolver::greedy(
             output);
     algorithm_formatter.start("Greedy");
 
-    std::vector<std::shared_ptr<const Column>> column_pool = parameters.column_pool;
+    // Column pool, shared by the column generation calls of all the nodes.
+    ColumnPool column_pool(model, parameters.column_pool);
     std::vector<std::shared_ptr<const Column>> initial_columns = parameters.initial_columns;
     std::vector<std::shared_ptr<const Cut>> cuts = parameters.initial_cuts;
+    // Stability center and alpha left by the previous node.
+    std::vector<Value> stability_center = parameters.column_generation_parameters.initial_stability_center;
+    Value wentges_smoothing_parameter = parameters.column_generation_parameters.initial_wentges_smoothing_parameter;
     ColumnMap fixed_columns;
 
     for (output.number_of_nodes = 0;; ++ output.number_of_nodes) {
+        COLUMNGENERATIONSOLVER_TRACE_SCOPE("node");
 
         // Check end.
         if (parameters.timer.needs_to_end())
@@ -32,6 +40,7 @@ const GreedyOutput columngenerationsolver::greedy(
             = parameters.column_generation_parameters;
         column_generation_parameters.timer = parameters.timer;
         column_generation_parameters.verbosity_level = 0;
+        column_generation_parameters.node_id = output.number_of_nodes;
         if (parameters.internal_diving == 2
                 || (parameters.internal_diving == 1 && output.number_of_nodes == 0)) {
             column_generation_parameters.internal_diving = 1;
@@ -44,6 +53,8 @@ const GreedyOutput columngenerationsolver::greedy(
                 || (parameters.rounding_heuristic == 1 && output.number_of_nodes == 0)) {
             column_generation_parameters.rounding_heuristic = 1;
         }
+        if (output.number_of_nodes > 0)
+            column_generation_parameters.tailing_off = parameters.non_root_tailing_off;
         column_generation_parameters.new_solution_callback = [&algorithm_formatter](
                 const Output& cg_output)
         {
@@ -81,8 +92,10 @@ const GreedyOutput columngenerationsolver::greedy(
                 column_generation_parameters.initial_columns.end(),
                 initial_columns.begin(),
                 initial_columns.end());
-        column_generation_parameters.column_pool = column_pool;
+        column_generation_parameters.shared_column_pool = &column_pool;
         column_generation_parameters.initial_cuts = cuts;
+        column_generation_parameters.initial_stability_center = stability_center;
+        column_generation_parameters.initial_wentges_smoothing_parameter = wentges_smoothing_parameter;
         column_generation_parameters.fixed_columns = fixed_columns.columns();
 
         // Solve.
@@ -94,16 +107,19 @@ const GreedyOutput columngenerationsolver::greedy(
         output.time_lpsolve += cg_output.time_lpsolve;
         output.time_pricing += cg_output.time_pricing;
         output.time_rounding_heuristic += cg_output.time_rounding_heuristic;
+        output.add_master_statistics(cg_output);
         output.number_of_column_generation_iterations += cg_output.number_of_column_generation_iterations;
         output.columns.insert(
                 output.columns.end(),
                 cg_output.columns.begin(),
                 cg_output.columns.end());
-        column_pool.insert(
-                column_pool.end(),
-                cg_output.columns.begin(),
-                cg_output.columns.end());
+        // The master LP of the column generation has been released.
+        output.memory_usage.column_pool = column_pool.memory();
+        output.memory_usage.columns = output.columns.capacity() * sizeof(std::shared_ptr<const Column>);
+        algorithm_formatter.update_memory_usage();
         cuts = cg_output.cuts;
+        stability_center = std::move(cg_output.stability_center);
+        wentges_smoothing_parameter = cg_output.wentges_smoothing_parameter;
 
         // Print header.
         if (output.number_of_nodes == 0)
@@ -0,0 +1,379 @@
+#include "columngenerationsolver/algorithms/lagrangian_relaxation.hpp"
+
+#include "columngenerationsolver/algorithm_formatter.hpp"
+
+#include "trace_events.hpp"
+
+#include <unordered_set>
+
+using namespace columngenerationsolver;
+
+const LagrangianRelaxationOutput columngenerationsolver::lagrangian_relaxation(
+        const Model& model,
+        const LagrangianRelaxationParameters& parameters)
+{
+    COLUMNGENERATIONSOLVER_TRACE_SCOPE("lagrangian_relaxation");
+    // Initial display.
+    LagrangianRelaxationOutput output(model);
+    AlgorithmFormatter algorithm_formatter(
+            model,
+            parameters,
+            output);
+    algorithm_formatter.start("Lagrangian relaxation");
+    algorithm_formatter.print_lagrangian_relaxation_header();
+
+    bool minimize = (model.objective_sense == optimizationtools::ObjectiveDirection::Minimize);
+    // +1 if the Lagrangian dual is a maximization problem (i.e. the model
+    // is a minimization problem), -1 otherwise.
+    Value sense = (minimize)? 1: -1;
+    RowIdx number_of_rows = model.rows.size();
+
+    if (!parameters.initial_duals.empty()
+            && (RowIdx)parameters.initial_duals.size() != number_of_rows) {
+        throw std::invalid_argument(
+                "columngenerationsolver::lagrangian_relaxation: "
+                "'initial_duals' must be empty or contain one value per "
+                "row.");
+    }
+
+    // Contribution of the fixed columns.
+    std::vector<Value> row_values(number_of_rows, 0.0);
+    Value c0 = 0.0;
+    for (const auto& p: parameters.fixed_columns) {
+        for (const LinearTerm& element: p.first->elements)
+            row_values[element.row] += p.second * element.coefficient;
+        c0 += p.second * p.first->objective_coefficient;
+    }
+
+    // Rows which still need to be covered, and their residual bounds (see
+    // 'column_generation').
+    std::vector<int8_t> is_new_row(number_of_rows, 0);
+    std::vector<RowIdx> new_rows;
+    for (RowIdx row_id = 0; row_id < number_of_rows; ++row_id) {
+        const Row& row = model.rows[row_id];
+        if (row.coefficient_lower_bound >= 0
+                && row_values[row_id] > row.upper_bound + row.feasibility_tolerance) {
+            algorithm_formatter.update_bound(
+                    (minimize)?
+                    std::numeric_limits<Value>::infinity():
+                    -std::numeric_limits<Value>::infinity());
+            algorithm_formatter.end();
+            return output;
+        }
+        if (row.coefficient_lower_bound >= 0
+                && row_values[row_id] >= row.upper_bound - row.feasibility_tolerance) {
+            continue;
+        }
+        is_new_row[row_id] = 1;
+        new_rows.push_back(row_id);
+    }
+    std::vector<Value> lower_bounds(number_of_rows, 0.0);
+    std::vector<Value> upper_bounds(number_of_rows, 0.0);
+    for (RowIdx row_id: new_rows) {
+        lower_bounds[row_id] = model.rows[row_id].lower_bound - row_values[row_id];
+        upper_bounds[row_id] = model.rows[row_id].upper_bound - row_values[row_id];
+    }
+
+    // Initialize pricing solver. Cuts are relaxed.
+    std::vector<std::shared_ptr<const Column>> infeasible_columns
+        = model.pricing_solver->initialize_pricing(
+                parameters.fixed_columns,
+                {},
+                parameters.branching_decisions,
+                std::numeric_limits<Value>::infinity());
+    model.pricing_solver->start_subproblem_generation();
+    std::unordered_set<std::shared_ptr<const Column>> infeasible_column_set(
+            infeasible_columns.begin(),
+            infeasible_columns.end());
+
+    // Static columns which may still take a non-zero value.
+    std::vector<std::shared_ptr<const Column>> static_columns;
+    for (const std::shared_ptr<const Column>& column: model.static_columns) {
+        bool ok = (infeasible_column_set.find(column) == infeasible_column_set.end());
+        for (const auto& p: parameters.fixed_columns)
+            if (p.first.get() == column.get())
+                ok = false;
+        for (const LinearTerm& element: column->elements) {
+            if (!ok)
+                break;
+            if (!is_new_row[element.row]) {
+                ok = false;
+            } else if (model.rows[element.row].coefficient_lower_bound >= 0
+                    && column->type == VariableType::Integer
+                    && row_values[element.row] + element.coefficient
+                    > model.rows[element.row].upper_bound) {
+                ok = false;
+            }
+        }
+        if (ok)
+            static_columns.push_back(column);
+    }
+
+    // Column pool.
+    std::unique_ptr<ColumnPool> call_column_pool = nullptr;
+    if (parameters.shared_column_pool == nullptr)
+        call_column_pool.reset(new ColumnPool(model, parameters.column_pool));
+    ColumnPool& column_pool = (parameters.shared_column_pool != nullptr)?
+        *parameters.shared_column_pool:
+        *call_column_pool;
+
+    // Projects the duals onto the domain of the Lagrangian dual: a row
+    // without lower (resp. upper) bound can't have a dual which would pair
+    // with it.
+    auto project = [&new_rows, &lower_bounds, &upper_bounds, minimize](
+            std::vector<Value>& duals)
+    {
+        for (RowIdx row_id: new_rows) {
+            bool no_lower_bound = (lower_bounds[row_id] == -std::numeric_limits<Value>::infinity());
+            bool no_upper_bound = (upper_bounds[row_id] == std::numeric_limits<Value>::infinity());
+            if ((minimize)? no_lower_bound: no_upper_bound)
+                duals[row_id] = (std::min)(duals[row_id], 0.0);
+            if ((minimize)? no_upper_bound: no_lower_bound)
+                duals[row_id] = (std::max)(duals[row_id], 0.0);
+        }
+    };
+
+    // Current duals.
+    std::vector<Value> duals(number_of_rows, 0.0);
+    for (RowIdx row_id: new_rows)
+        if (!parameters.initial_duals.empty())
+            duals[row_id] = parameters.initial_duals[row_id];
+    project(duals);
+    // Best duals, and the Lagrangian bound they give.
+    std::vector<Value> best_duals = duals;
+    Value best_value = -sense * std::numeric_limits<Value>::infinity();
+
+    // Averaged primal solution: row activities, values of the generated
+    // columns (by column pool index) and values of the static columns.
+    std::vector<Value> averaged_row_values(number_of_rows, 0.0);
+    std::vector<std::pair<ColIdx, Value>> averaged_columns;
+    std::unordered_map<ColIdx, ColIdx> averaged_column_positions;
+    std::vector<Value> averaged_static_values(static_columns.size(), 0.0);
+
+    std::vector<Value> lagrangian_row_values(number_of_rows, 0.0);
+    std::vector<Value> static_values(static_columns.size(), 0.0);
+    std::vector<Value> subgradient(number_of_rows, 0.0);
+    Value step_size_parameter = parameters.step_size_parameter;
+    Counter number_of_iterations_without_improvement = 0;
+    std::vector<std::pair<std::shared_ptr<const Cut>, Value>> cut_duals;
+
+    for (output.number_of_iterations = 1;
+            ;
+            ++output.number_of_iterations) {
+
+        // Check time.
+        if (parameters.timer.needs_to_end())
+            break;
+
+        // Solve the Lagrangian subproblem at the current duals.
+        auto start_pricing = std::chrono::high_resolution_clock::now();
+        PricingContext pricing_context = PricingContext::create(parameters.timer);
+        model.pricing_solver->update_pricing_context(false, duals, pricing_context);
+        auto pricing_output = model.pricing_solver->solve_pricing(
+                false,
+                duals,
+                cut_duals,
+                parameters.pricing_level,
+                pricing_context);
+        auto end_pricing = std::chrono::high_resolution_clock::now();
+        auto time_span_pricing = std::chrono::duration_cast<std::chrono::duration<double>>(end_pricing - start_pricing);
+        output.time_pricing += time_span_pricing.count();
+
+        // Lagrangian solution of the generated columns.
+        std::vector<ColIdx> column_ids;
+        for (const std::shared_ptr<const Column>& column: pricing_output.columns) {
+            model.check_generated_column(column);
+            auto res = column_pool.add(column);
+            if (res.second)
+                output.columns.push_back(column);
+            column_ids.push_back(res.first);
+        }
+        output.maximum_column_pool_size = (std::max)(
+                output.maximum_column_pool_size,
+                column_pool.number_of_columns());
+        const std::vector<Value>& multiplicities = pricing_output.lagrangian_column_multiplicities;
+        if (!multiplicities.empty()
+                && multiplicities.size() != pricing_output.columns.size()) {
+            throw std::invalid_argument(
+                    "columngenerationsolver::lagrangian_relaxation: "
+                    "'lagrangian_column_multiplicities' must have one entry per column; "
+                    "number of columns: " + std::to_string(pricing_output.columns.size()) + "; "
+                    "number of multiplicities: " + std::to_string(multiplicities.size()) + ".");
+        }
+        // Without the multiplicities, the columns returned don't describe
+        // the solution whose row values are given, so the averaged columns
+        // wouldn't match the averaged row values.
+        if (!pricing_output.lagrangian_column_values.empty()
+                && !pricing_output.columns.empty()
+                && multiplicities.empty()) {
+            output.has_primal_solution = false;
+        }
+        std::fill(lagrangian_row_values.begin(), lagrangian_row_values.end(), 0.0);
+        if (!pricing_output.lagrangian_column_values.empty()) {
+            lagrangian_row_values = pricing_output.lagrangian_column_values;
+        } else {
+            for (ColIdx pos = 0; pos < (ColIdx)pricing_output.columns.size(); ++pos) {
+                Value multiplicity = (multiplicities.empty())? 1.0: multiplicities[pos];
+                for (const LinearTerm& element: pricing_output.columns[pos]->elements)
+                    lagrangian_row_values[element.row] += multiplicity * element.coefficient;
+            }
+        }
+
+        // Lagrangian value. Static columns go to whichever of their bounds
+        // minimizes (resp. maximizes) their reduced cost.
+        Value lagrangian_value = c0;
+        bool lagrangian_value_is_valid = (pricing_output.overcost != std::numeric_limits<Value>::infinity());
+        if (lagrangian_value_is_valid)
+            lagrangian_value += pricing_output.overcost;
+        for (RowIdx row_id: new_rows) {
+            if (duals[row_id] == 0)
+                continue;
+            bool lower = ((duals[row_id] > 0) == minimize);
+            lagrangian_value += duals[row_id] * ((lower)? lower_bounds[row_id]: upper_bounds[row_id]);
+        }
+        for (ColIdx static_pos = 0;
+                static_pos < (ColIdx)static_columns.size();
+                ++static_pos) {
+            const Column& column = *static_columns[static_pos];
+            Value reduced_cost = model.compute_reduced_cost(false, column, duals, cut_duals);
+            Value value = (sense * reduced_cost < 0)? column.upper_bound: column.lower_bound;
+            if (value == std::numeric_limits<Value>::infinity()
+                    || value == -std::numeric_limits<Value>::infinity()) {
+                lagrangian_value_is_valid = false;
+                value = 0.0;
+            }
+            static_values[static_pos] = value;
+            lagrangian_value += reduced_cost * value;
+            for (const LinearTerm& element: column.elements)
+                lagrangian_row_values[element.row] += value * element.coefficient;
+        }
+
+        // Update bound.
+        if (lagrangian_value_is_valid
+                && sense * lagrangian_value > sense * best_value + FFOT_TOL) {
+            best_value = lagrangian_value;
+            best_duals = duals;
+            algorithm_formatter.update_bound(best_value);
+            step_size_parameter = (std::min)(2.0, step_size_parameter * 1.1);
+            number_of_iterations_without_improvement = 0;
+        } else {
+            number_of_iterations_without_improvement++;
+            if (number_of_iterations_without_improvement
+                    >= parameters.maximum_number_of_iterations_without_improvement) {
+                step_size_parameter /= 2;
+                number_of_iterations_without_improvement = 0;
+                output.number_of_step_size_decreases++;
+            }
+        }
+
+        // Update the averaged primal solution.
+        Value alpha = (output.number_of_iterations == 1)? 1.0: parameters.volume_parameter;
+        for (RowIdx row_id: new_rows) {
+            averaged_row_values[row_id]
+                = alpha * lagrangian_row_values[row_id]
+                + (1 - alpha) * averaged_row_values[row_id];
+        }
+        for (auto& p: averaged_columns)
+            p.second *= (1 - alpha);
+        for (ColIdx pos = 0; pos < (ColIdx)column_ids.size(); ++pos) {
+            ColIdx column_id = column_ids[pos];
+            Value multiplicity = (multiplicities.empty())? 1.0: multiplicities[pos];
+            auto res = averaged_column_positions.insert({column_id, (ColIdx)averaged_columns.size()});
+            if (res.second)
+                averaged_columns.push_back({column_id, 0.0});
+            averaged_columns[res.first->second].second += alpha * multiplicity;
+        }
+        for (ColIdx static_pos = 0;
+                static_pos < (ColIdx)static_columns.size();
+                ++static_pos) {
+            averaged_static_values[static_pos]
+                = alpha * static_values[static_pos]
+                + (1 - alpha) * averaged_static_values[static_pos];
+        }
+        Value primal_value = (output.has_primal_solution)?
+            c0:
+            sense * std::numeric_limits<Value>::infinity();
+        for (const auto& p: averaged_columns)
+            primal_value += p.second * column_pool.column(p.first)->objective_coefficient;
+        for (ColIdx static_pos = 0;
+                static_pos < (ColIdx)static_columns.size();
+                ++static_pos) {
+            primal_value += averaged_static_values[static_pos] * static_columns[static_pos]->objective_coefficient;
+        }
+
+        // Subgradient at the averaged primal solution, i.e. its violation
+        // of the rows.
+        Value maximum_violation = 0.0;
+        for (RowIdx row_id: new_rows) {
+            subgradient[row_id]
+                = (std::min)(0.0, upper_bounds[row_id] - averaged_row_values[row_id])
+                + (std::max)(0.0, lower_bounds[row_id] - averaged_row_values[row_id]);
+            maximum_violation = (std::max)(maximum_violation, std::abs(subgradient[row_id]));
+        }
+        Value subgradient_norm = norm(new_rows, subgradient);
+
+        algorithm_formatter.print_lagrangian_relaxation_iteration(
+                output.number_of_iterations,
+                lagrangian_value,
+                primal_value,
+                step_size_parameter);
+
+        // Check optimality.
+        if (output.optimal())
+            break;
+        if (std::isfinite(best_value)
+                && output.has_primal_solution
+                && maximum_violation <= parameters.tolerance
+                && std::abs(primal_value - best_value)
+                <= parameters.tolerance * (std::max)(1.0, std::abs(best_value))) {
+            break;
+        }
+        if (subgradient_norm == 0.0)
+            break;
+
+        // Check iteration limit.
+        if (parameters.maximum_number_of_iterations != -1
+                && output.number_of_iterations >= parameters.maximum_number_of_iterations) {
+            break;
+        }
+
+        // Next duals: a step from the best duals along the violation of the
+        // averaged primal solution, with Polyak's step size towards a
+        // target slightly better than the current bound.
+        Value step_size = 0.0;
+        if (std::isfinite(best_value)) {
+            Value target_gap = parameters.target_relative_gap * (std::max)(1.0, std::abs(best_value));
+            step_size = step_size_parameter * target_gap / (subgradient_norm * subgradient_norm);
+        } else {
+            step_size = step_size_parameter / subgradient_norm;
+        }
+        for (RowIdx row_id: new_rows)
+            duals[row_id] = best_duals[row_id] + sense * step_size * subgradient[row_id];
+        project(duals);
+    }
+
+    // Averaged primal solution.
+    if (output.has_primal_solution) {
+        SolutionBuilder solution_builder;
+        solution_builder.set_model(model);
+        for (const auto& p: parameters.fixed_columns)
+            solution_builder.add_column(p.first, p.second);
+        for (const auto& p: averaged_columns)
+            if (p.second >= FFOT_TOL)
+                solution_builder.add_column(column_pool.column(p.first), p.second);
+        for (ColIdx static_pos = 0;
+                static_pos < (ColIdx)static_columns.size();
+                ++static_pos) {
+            if (std::abs(averaged_static_values[static_pos]) >= FFOT_TOL) {
+                solution_builder.add_column(
+                        static_columns[static_pos],
+                        averaged_static_values[static_pos]);
+            }
+        }
+        output.relaxation_solution = solution_builder.build();
+    }
+    output.duals = best_duals;
+
+    algorithm_formatter.end();
+    return output;
+}
@@ -2,7 +2,10 @@
 
 #include "columngenerationsolver/algorithm_formatter.hpp"
 
+#include "trace_events.hpp"
+
 #include <set>
+#include <unordered_map>
 
 using namespace columngenerationsolver;
 
@@ -27,6 +30,16 @@ struct LimitedDiscrepancySearchNode
      */
     std::vector<std::shared_ptr<const Cut>> cuts;
 
+    /**
+     * Final stability center of the dual smoothing of this node (see
+     * 'ColumnGenerationOutput::stability_center'), used to warm-start its
+     * children.
+     */
+    std::shared_ptr<const std::vector<Value>> stability_center;
+
+    /** Wentges smoothing parameter matching 'stability_center'. */
+    Value wentges_smoothing_parameter = -1;
+
     bool skip_relaxation = false;
 
     /** Column branched on at this node. */
@@ -48,6 +61,199 @@ struct LimitedDiscrepancySearchNode
 
     /** Depth of the node. */
     ColIdx depth = 0;
+
+    /**
+     * Number of children of this node which are still alive, i.e. open,
+     * being processed or with alive children themselves, and so keep this
+     * node alive through their 'parent'.
+     */
+    Counter number_of_alive_children = 0;
+};
+
+/**
+ * Approximate memory used by a node. The relaxation solution and the
+ * stability center are only counted for the node which owns them, not for
+ * the children sharing them with their parent.
+ */
+Counter memory(const LimitedDiscrepancySearchNode& node)
+{
+    Counter res = sizeof(LimitedDiscrepancySearchNode)
+        + node.cuts.capacity() * sizeof(std::shared_ptr<const Cut>);
+    if (node.relaxation_solution != nullptr
+            && (node.parent == nullptr
+                || node.relaxation_solution != node.parent->relaxation_solution)) {
+        res += memory(*node.relaxation_solution);
+    }
+    if (node.stability_center != nullptr
+            && (node.parent == nullptr
+                || node.stability_center != node.parent->stability_center)) {
+        res += node.stability_center->capacity() * sizeof(Value);
+    }
+    return res;
+}
+
+/**
+ * Fixed columns, tabu columns and row values of the node being processed.
+ *
+ * The branchings applied on the path from the root to the current node are
+ * recorded in a trail, so that moving to another node only undoes the
+ * branchings down to the common ancestor of both nodes, then applies the
+ * ones from there to the new node.
+ */
+class LimitedDiscrepancySearchState
+{
+
+public:
+
+    /** Constructor. */
+    LimitedDiscrepancySearchState(const Model& model)
+    {
+        contribution_.row_values.resize(model.rows.size(), 0.0);
+    }
+
+    /** Get the fixed columns. */
+    const std::vector<std::pair<std::shared_ptr<const Column>, Value>>& fixed_columns() const { return fixed_columns_; }
+
+    /** Get the value of a fixed column (0 if it is not fixed). */
+    Value fixed_column_value(const std::shared_ptr<const Column>& column) const
+    {
+        auto it = fixed_column_positions_.find(column.get());
+        if (it == fixed_column_positions_.end())
+            return 0;
+        return fixed_columns_[it->second].second;
+    }
+
+    /** Get the tabu columns. */
+    std::unordered_set<std::shared_ptr<const Column>>& tabu() { return tabu_; }
+
+    /** Get the contribution of the fixed columns. */
+    const FixedColumnsContribution& contribution() const { return contribution_; }
+
+    /** Move to a node. */
+    void move_to(const std::shared_ptr<LimitedDiscrepancySearchNode>& node)
+    {
+        // Nodes from 'node' up to the common ancestor (excluded).
+        std::vector<std::shared_ptr<LimitedDiscrepancySearchNode>> nodes_to_apply;
+        std::shared_ptr<LimitedDiscrepancySearchNode> node_tmp = node;
+        while (node_tmp->depth > 0
+                && (node_tmp->depth > (ColIdx)trail_.size()
+                    || trail_[node_tmp->depth - 1].node != node_tmp)) {
+            nodes_to_apply.push_back(node_tmp);
+            node_tmp = node_tmp->parent;
+        }
+        while ((ColIdx)trail_.size() > node_tmp->depth)
+            undo();
+        for (auto it = nodes_to_apply.rbegin(); it != nodes_to_apply.rend(); ++it)
+            apply(*it);
+    }
+
+private:
+
+    /** Entry of the trail. */
+    struct TrailEntry
+    {
+        /** Node whose branching has been applied. */
+        std::shared_ptr<LimitedDiscrepancySearchNode> node;
+
+        /** Value of the column before the branching (-1: not fixed). */
+        Value previous_value;
+
+        /** 'true' iff the branching added the column to the tabu set. */
+        bool tabu_added;
+
+        /**
+         * Values, before the branching, of the rows of the column, in the
+         * order of its elements, and of the objective. They are restored
+         * as is rather than by subtracting the contribution of the
+         * column, which would accumulate rounding errors.
+         */
+        std::vector<Value> previous_row_values;
+        Value previous_objective_value;
+    };
+
+    /** Apply the branching of a child of the current node. */
+    void apply(const std::shared_ptr<LimitedDiscrepancySearchNode>& node)
+    {
+        TrailEntry entry;
+        entry.node = node;
+        entry.previous_value = -1;
+        entry.previous_row_values.reserve(node->column->elements.size());
+        for (const LinearTerm& element: node->column->elements)
+            entry.previous_row_values.push_back(contribution_.row_values[element.row]);
+        entry.previous_objective_value = contribution_.objective_value;
+        Value value = node->value;
+        auto it = fixed_column_positions_.find(node->column.get());
+        if (it == fixed_column_positions_.end()) {
+            fixed_column_positions_[node->column.get()] = fixed_columns_.size();
+            fixed_columns_.push_back({node->column, value});
+            update_contribution(*node->column, value);
+        } else {
+            entry.previous_value = fixed_columns_[it->second].second;
+            if (entry.previous_value < value) {
+                fixed_columns_[it->second].second = value;
+                update_contribution(*node->column, value - entry.previous_value);
+            }
+        }
+        entry.tabu_added = node->tabu && tabu_.insert(node->column).second;
+        trail_.push_back(std::move(entry));
+    }
+
+    /** Undo the last branching applied. */
+    void undo()
+    {
+        const TrailEntry& entry = trail_.back();
+        const std::shared_ptr<const Column>& column = entry.node->column;
+        Counter pos = fixed_column_positions_[column.get()];
+        if (entry.previous_value == -1) {
+            // Branchings are undone in reverse order, so the column is the
+            // last one fixed.
+            fixed_column_positions_.erase(column.get());
+            fixed_columns_.pop_back();
+        } else {
+            fixed_columns_[pos].second = entry.previous_value;
+        }
+        // Restored in reverse order, so that a row appearing twice in the
+        // column gets the value saved first.
+        for (Counter element_pos = (Counter)column->elements.size() - 1;
+                element_pos >= 0;
+                --element_pos) {
+            contribution_.row_values[column->elements[element_pos].row]
+                = entry.previous_row_values[element_pos];
+        }
+        contribution_.objective_value = entry.previous_objective_value;
+        if (entry.tabu_added)
+            tabu_.erase(column);
+        trail_.pop_back();
+    }
+
+    /** Add 'delta' times a column to the contribution. */
+    void update_contribution(const Column& column, Value delta)
+    {
+        if (delta == 0)
+            return;
+        for (const LinearTerm& element: column.elements)
+            contribution_.row_values[element.row] += delta * element.coefficient;
+        contribution_.objective_value += delta * column.objective_coefficient;
+    }
+
+    /** Fixed columns. */
+    std::vector<std::pair<std::shared_ptr<const Column>, Value>> fixed_columns_;
+
+    /** Position of each fixed column in 'fixed_columns_'. */
+    std::unordered_map<const Column*, Counter> fixed_column_positions_;
+
+    /** Tabu columns. */
+    std::unordered_set<std::shared_ptr<const Column>> tabu_;
+
+    /** Contribution of the fixed columns. */
+    FixedColumnsContribution contribution_;
+
+    /**
+     * Trail: 'trail_[d - 1]' is the branching of the ancestor of depth 'd'
+     * of the current node.
+     */
+    std::vector<TrailEntry> trail_;
+
 };
 
 }
@@ -56,6 +262,7 @@ const LimitedDiscrepancySearchOutput columngenerationsolver::limited_discrepancy
         const Model& model,
         const LimitedDiscrepancySearchParameters& parameters)
 {
+    COLUMNGENERATIONSOLVER_TRACE_SCOPE("limited_discrepancy_search");
     // Initial display.
     LimitedDiscrepancySearchOutput output(model);
     AlgorithmFormatter algorithm_formatter(
@@ -64,9 +271,8 @@ const LimitedDiscrepancySearchOutput columngenerationsolver::limited_discrepancy
             output);
     algorithm_formatter.start("Limited discrepancy search");
 
-    std::vector<std::shared_ptr<const Column>> column_pool = parameters.column_pool;
-
-    ColumnHasher column_hasher(model);
+    // Column pool, shared by the column generation calls of all the nodes.
+    ColumnPool column_pool(model, parameters.column_pool);
 
     // Nodes
     auto comp = [](
@@ -92,17 +298,50 @@ const LimitedDiscrepancySearchOutput columngenerationsolver::limited_discrepancy
     };
     std::multiset<std::shared_ptr<LimitedDiscrepancySearchNode>, decltype(comp)> nodes(comp);
 
+    // Memory used by the open nodes and by the processed nodes they keep
+    // alive through their 'parent'. A processed node is counted from the
+    // insertion of its first child to its release, so that each node is
+    // only accounted for a constant number of times.
+    Counter open_nodes_memory = 0;
+    auto insert_node = [&nodes, &open_nodes_memory](
+            const std::shared_ptr<LimitedDiscrepancySearchNode>& node)
+    {
+        nodes.insert(node);
+        open_nodes_memory += memory(*node);
+        LimitedDiscrepancySearchNode* parent = node->parent.get();
+        if (parent != nullptr && parent->number_of_alive_children++ == 0)
+            open_nodes_memory += memory(*parent);
+    };
+    // Release a processed node if it has no alive child, and the ancestors
+    // it was the last alive descendant of.
+    auto release_node = [&open_nodes_memory](
+            const LimitedDiscrepancySearchNode& node)
+    {
+        if (node.number_of_alive_children > 0)
+            return;
+        for (LimitedDiscrepancySearchNode* ancestor = node.parent.get();
+                ancestor != nullptr;
+                ancestor = ancestor->parent.get()) {
+            ancestor->number_of_alive_children--;
+            if (ancestor->number_of_alive_children > 0)
+                break;
+            open_nodes_memory -= memory(*ancestor);
+        }
+    };
     // Root node.
     auto root = std::make_shared<LimitedDiscrepancySearchNode>();
-    nodes.insert(root);
+    insert_node(root);
 
     std::shared_ptr<LimitedDiscrepancySearchNode> node = nullptr;
-    std::shared_ptr<LimitedDiscrepancySearchNode> node_prev = nullptr;
-    ColumnMap fixed_columns;
-    std::unordered_set<std::shared_ptr<const Column>> tabu;
+    LimitedDiscrepancySearchState state(model);
     while (!nodes.empty()) {
         //std::cout << "nodes.size() " << nodes.size() << std::endl;
 
+        // Release the node processed at the previous iteration, whichever
+        // way its processing ended.
+        if (node != nullptr)
+            release_node(*node);
+
         // Check end.
         if (parameters.timer.needs_to_end())
             break;
@@ -111,9 +350,16 @@ const LimitedDiscrepancySearchOutput columngenerationsolver::limited_discrepancy
             break;
 
         // Get node
-        node_prev = node;
         node = *nodes.begin();
         nodes.erase(nodes.begin());
+        open_nodes_memory -= memory(*node);
+
+        // Update memory usage. The master LPs of the column generations
+        // are released at the end of each of them.
+        output.memory_usage.column_pool = column_pool.memory();
+        output.memory_usage.columns = output.columns.capacity() * sizeof(std::shared_ptr<const Column>);
+        output.memory_usage.open_nodes = open_nodes_memory;
+        algorithm_formatter.update_memory_usage();
 
         // Check discrepancy limit.
         if (!parameters.continue_until_feasible
@@ -129,23 +375,9 @@ const LimitedDiscrepancySearchOutput columngenerationsolver::limited_discrepancy
             break;
         }
 
-        // Compute fixed_columns and tabu.
-        if (node->parent != nullptr
-                && node_prev == node->parent) {
-            fixed_columns.max_column_value(node->column, node->value);
-            if (node->tabu)
-                tabu.insert(node->column);
-        } else {
-            fixed_columns = ColumnMap();
-            tabu.clear();
-            for (auto node_tmp = node;
-                    node_tmp->parent != NULL;
-                    node_tmp = node_tmp->parent) {
-                fixed_columns.max_column_value(node_tmp->column, node_tmp->value);
-                if (node_tmp->tabu)
-                    tabu.insert(node_tmp->column);
-            }
-        }
+        // Update fixed columns, tabu and row values.
+        state.move_to(node);
+        const auto& tabu = state.tabu();
 
         // Update output statistics.
         output.number_of_nodes++;
@@ -169,14 +401,18 @@ const LimitedDiscrepancySearchOutput columngenerationsolver::limited_discrepancy
 
             node->relaxation_solution = node->parent->relaxation_solution;
             node->cuts = node->parent->cuts;
+            node->stability_center = node->parent->stability_center;
+            node->wentges_smoothing_parameter = node->parent->wentges_smoothing_parameter;
 
         } else {
+            COLUMNGENERATIONSOLVER_TRACE_SCOPE("node");
 
             // Run column generation
             ColumnGenerationParameters column_generation_parameters
                 = parameters.column_generation_parameters;
             column_generation_parameters.timer = parameters.timer;
             column_generation_parameters.verbosity_level = 0;
+            column_generation_parameters.node_id = output.number_of_nodes;
             if (parameters.internal_diving == 2
                     || (parameters.internal_diving == 1 && node->depth == 0)) {
                 column_generation_parameters.internal_diving = 1;
@@ -189,6 +425,8 @@ const LimitedDiscrepancySearchOutput columngenerationsolver::limited_discrepancy
                     || (parameters.rounding_heuristic == 1 && node->depth == 0)) {
                 column_generation_parameters.rounding_heuristic = 1;
             }
+            if (node->depth > 0)
+                column_generation_parameters.tailing_off = parameters.non_root_tailing_off;
             column_generation_parameters.new_solution_callback = [&algorithm_formatter](
                     const Output& cg_output)
             {
@@ -234,12 +472,18 @@ const LimitedDiscrepancySearchOutput columngenerationsolver::limited_discrepancy
                     column_generation_parameters.initial_columns.push_back(p.first);
                 }
             }
-            column_generation_parameters.column_pool = column_pool;
+            column_generation_parameters.shared_column_pool = &column_pool;
             column_generation_parameters.initial_cuts = (node->parent == nullptr)?
                 parameters.initial_cuts:
                 node->parent->cuts;
-            column_generation_parameters.fixed_columns = fixed_columns.columns();
-            column_generation_parameters.tabu = &tabu;
+            if (node->parent != nullptr
+                    && node->parent->stability_center != nullptr) {
+                column_generation_parameters.initial_stability_center = *node->parent->stability_center;
+                column_generation_parameters.initial_wentges_smoothing_parameter = node->parent->wentges_smoothing_parameter;
+            }
+            column_generation_parameters.fixed_columns = state.fixed_columns();
+            column_generation_parameters.fixed_columns_contribution = &state.contribution();
+            column_generation_parameters.tabu = &state.tabu();
 
             // Solve.
             auto cg_output = column_generation(
@@ -250,16 +494,18 @@ const LimitedDiscrepancySearchOutput columngenerationsolver::limited_discrepancy
             output.time_lpsolve += cg_output.time_lpsolve;
             output.time_pricing += cg_output.time_pricing;
             output.time_rounding_heuristic += cg_output.time_rounding_heuristic;
+            output.add_master_statistics(cg_output);
             output.number_of_column_generation_iterations += cg_output.number_of_column_generation_iterations;
             output.columns.insert(
                     output.columns.end(),
                     cg_output.columns.begin(),
                     cg_output.columns.end());
-            column_pool.insert(
-                    column_pool.end(),
-                    cg_output.columns.begin(),
-                    cg_output.columns.end());
             node->cuts = cg_output.cuts;
+            if (!cg_output.stability_center.empty()) {
+                node->stability_center = std::make_shared<const std::vector<Value>>(
+                        std::move(cg_output.stability_center));
+                node->wentges_smoothing_parameter = cg_output.wentges_smoothing_parameter;
+            }
 
             //std::cout << "bound " << cg_output.solution_value << std::endl;
             if (parameters.timer.needs_to_end())
@@ -349,7 +595,7 @@ const LimitedDiscrepancySearchOutput columngenerationsolver::limited_discrepancy
                 node->relaxation_solution->objective_value());
 
         //std::cout << "fc";
-        //for (auto p: fixed_columns.columns())
+        //for (auto p: state.fixed_columns())
         //    std::cout << " " << *(p.first) << " " << p.second << ";";
         //std::cout << std::endl;
 
@@ -372,8 +618,8 @@ const LimitedDiscrepancySearchOutput columngenerationsolver::limited_discrepancy
                 continue;
 
             Value main_branch_value = std::floor(value);
-            if (main_branch_value <= fixed_columns.get_column_value(column, 0)) {
-                main_branch_value = fixed_columns.get_column_value(column, 0) + 1;
+            if (main_branch_value <= state.fixed_column_value(column)) {
+                main_branch_value = state.fixed_column_value(column) + 1;
             } else {
                 n++;
             }
@@ -413,7 +659,7 @@ const LimitedDiscrepancySearchOutput columngenerationsolver::limited_discrepancy
         if (value_best > value_frac_best)
             child_1->discrepancy_2 += value_best - value_frac_best;
         child_1->depth = node->depth + 1;
-        nodes.insert(child_1);
+        insert_node(child_1);
 
         // value_best >= fixed_lower_bound + 1 always (see computation above),
         // so value_best - 1 >= fixed_lower_bound: no guard needed here.
@@ -426,9 +672,9 @@ const LimitedDiscrepancySearchOutput columngenerationsolver::limited_discrepancy
         child_2->discrepancy = node->discrepancy + 1;
         child_2->discrepancy_2 = node->discrepancy_2 + (value_frac_best - child_2->value);
         child_2->depth = node->depth + 1;
-        nodes.insert(child_2);
+        insert_node(child_2);
 
-        if (value_best - 2 >= fixed_columns.get_column_value(column_best, 0)) {
+        if (value_best - 2 >= state.fixed_column_value(column_best)) {
             auto child_3 = std::make_shared<LimitedDiscrepancySearchNode>();
             child_3->parent = node;
             child_3->column = column_best;
@@ -438,10 +684,10 @@ const LimitedDiscrepancySearchOutput columngenerationsolver::limited_discrepancy
             child_3->discrepancy = node->discrepancy + 2;
             child_3->discrepancy_2 = node->discrepancy_2 + (value_frac_best - child_3->value);
             child_3->depth = node->depth + 1;
-            nodes.insert(child_3);
+            insert_node(child_3);
         }
 
-        if (value_best - 3 >= fixed_columns.get_column_value(column_best, 0)) {
+        if (value_best - 3 >= state.fixed_column_value(column_best)) {
             auto child_4 = std::make_shared<LimitedDiscrepancySearchNode>();
             child_4->parent = node;
             child_4->column = column_best;
@@ -451,7 +697,7 @@ const LimitedDiscrepancySearchOutput columngenerationsolver::limited_discrepancy
             child_4->discrepancy = node->discrepancy + 3;
             child_4->discrepancy_2 = node->discrepancy_2 + (value_frac_best - child_4->value);
             child_4->depth = node->depth + 1;
-            nodes.insert(child_4);
+            insert_node(child_4);
         }
     }
 
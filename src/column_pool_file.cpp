@@ -0,0 +1,313 @@
+#include "columngenerationsolver/column_pool_file.hpp"
+
+#include <fstream>
+#include <cstring>
+
+using namespace columngenerationsolver;
+
+namespace
+{
+
+/** Magic string, the last byte is the version of the format. */
+const char column_pool_magic[8] = {'C', 'G', 'S', 'P', 'O', 'O', 'L', 1};
+
+/** Marker of the byte order. */
+const uint64_t column_pool_byte_order = 0x0102030405060708ULL;
+
+/** Header of a column pool file. */
+struct ColumnPoolHeader
+{
+    char magic[8];
+    uint64_t byte_order;
+    int64_t number_of_rows;
+    int64_t number_of_columns;
+    int64_t number_of_elements;
+    int64_t names_size;
+    int64_t extras_size;
+    int64_t reserved;
+};
+
+/** Size of a column pool file. */
+int64_t column_pool_file_size(const ColumnPoolHeader& header)
+{
+    int64_t n = header.number_of_columns;
+    int64_t m = header.number_of_elements;
+    return sizeof(ColumnPoolHeader)
+        + 4 * n * sizeof(Value)
+        + 3 * (n + 1) * sizeof(int64_t)
+        + m * (sizeof(int64_t) + sizeof(Value))
+        + n
+        + header.names_size
+        + header.extras_size;
+}
+
+template <typename T>
+void write_array(
+        std::ofstream& file,
+        const std::vector<T>& array)
+{
+    file.write((const char*)array.data(), array.size() * sizeof(T));
+}
+
+/**
+ * Return the array of 'size' elements of type 'T' at 'position'.
+ *
+ * The elements are copied with 'std::memcpy' since the bytes of the file
+ * may not be accessed through a pointer to 'T'.
+ */
+template <typename T>
+std::vector<T> read_array(
+        const char* data,
+        int64_t& position,
+        int64_t size)
+{
+    std::vector<T> array(size);
+    if (size > 0)
+        std::memcpy(array.data(), data + position, size * sizeof(T));
+    position += size * sizeof(T);
+    return array;
+}
+
+/**
+ * Check that 'starts' are the positions of the first items of consecutive
+ * ranges covering '[0, size)'.
+ */
+bool check_starts(
+        const std::vector<int64_t>& starts,
+        int64_t number_of_columns,
+        int64_t size)
+{
+    if (starts[0] != 0 || starts[number_of_columns] != size)
+        return false;
+    for (int64_t column_id = 0; column_id < number_of_columns; ++column_id)
+        if (starts[column_id] > starts[column_id + 1])
+            return false;
+    return true;
+}
+
+}
+
+void columngenerationsolver::write_column_pool(
+        const std::string& path,
+        RowIdx number_of_rows,
+        const std::vector<std::shared_ptr<const Column>>& columns,
+        const ColumnExtraSerializer& serialize_extra)
+{
+    int64_t n = columns.size();
+    std::vector<Value> objective_coefficients(n);
+    std::vector<Value> lower_bounds(n);
+    std::vector<Value> upper_bounds(n);
+    std::vector<Value> branching_priorities(n);
+    std::vector<int64_t> element_starts(n + 1, 0);
+    std::vector<int64_t> rows;
+    std::vector<Value> coefficients;
+    std::vector<int64_t> name_starts(n + 1, 0);
+    std::vector<int64_t> extra_starts(n + 1, 0);
+    std::vector<uint8_t> types(n);
+    std::string names;
+    std::string extras;
+    for (int64_t column_id = 0; column_id < n; ++column_id) {
+        const Column& column = *columns[column_id];
+        objective_coefficients[column_id] = column.objective_coefficient;
+        lower_bounds[column_id] = column.lower_bound;
+        upper_bounds[column_id] = column.upper_bound;
+        branching_priorities[column_id] = column.branching_priority;
+        for (const LinearTerm& element: column.elements) {
+            if (element.row < 0 || element.row >= number_of_rows) {
+                throw std::invalid_argument(
+                        "columngenerationsolver::write_column_pool: "
+                        "invalid row; "
+                        "column: " + std::to_string(column_id) + "; "
+                        "row: " + std::to_string(element.row) + "; "
+                        "number_of_rows: " + std::to_string(number_of_rows) + ".");
+            }
+            rows.push_back(element.row);
+            coefficients.push_back(element.coefficient);
+        }
+        element_starts[column_id + 1] = rows.size();
+        names += column.name;
+        name_starts[column_id + 1] = names.size();
+        if (serialize_extra)
+            extras += serialize_extra(column);
+        extra_starts[column_id + 1] = extras.size();
+        types[column_id] = (column.type == VariableType::Integer);
+    }
+
+    ColumnPoolHeader header;
+    std::memcpy(header.magic, column_pool_magic, sizeof(header.magic));
+    header.byte_order = column_pool_byte_order;
+    header.number_of_rows = number_of_rows;
+    header.number_of_columns = n;
+    header.number_of_elements = rows.size();
+    header.names_size = names.size();
+    header.extras_size = extras.size();
+    header.reserved = 0;
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.good()) {
+        throw std::runtime_error(
+                "columngenerationsolver::write_column_pool: "
+                "unable to open file \"" + path + "\".");
+    }
+    file.write((const char*)&header, sizeof(header));
+    write_array(file, objective_coefficients);
+    write_array(file, lower_bounds);
+    write_array(file, upper_bounds);
+    write_array(file, branching_priorities);
+    write_array(file, element_starts);
+    write_array(file, rows);
+    write_array(file, coefficients);
+    write_array(file, name_starts);
+    write_array(file, extra_starts);
+    write_array(file, types);
+    file.write(names.data(), names.size());
+    file.write(extras.data(), extras.size());
+    if (!file.good()) {
+        throw std::runtime_error(
+                "columngenerationsolver::write_column_pool: "
+                "unable to write file \"" + path + "\".");
+    }
+}
+
+std::vector<std::shared_ptr<const Column>> columngenerationsolver::read_column_pool(
+        const std::string& path,
+        const Model& model,
+        const ColumnExtraDeserializer& deserialize_extra)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.good()) {
+        throw std::runtime_error(
+                "columngenerationsolver::read_column_pool: "
+                "unable to open file \"" + path + "\".");
+    }
+    int64_t file_size = file.tellg();
+    file.seekg(0);
+
+    // Read the whole file into a buffer.
+    std::vector<char> buffer(file_size);
+    const char* data = buffer.data();
+    file.read(buffer.data(), file_size);
+    if (!file.good()) {
+        throw std::runtime_error(
+                "columngenerationsolver::read_column_pool: "
+                "unable to read file \"" + path + "\".");
+    }
+
+    ColumnPoolHeader header;
+    if (file_size < (int64_t)sizeof(header)) {
+        throw std::runtime_error(
+                "columngenerationsolver::read_column_pool: "
+                "\"" + path + "\" is not a column pool file.");
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, column_pool_magic, sizeof(header.magic) - 1) != 0) {
+        throw std::runtime_error(
+                "columngenerationsolver::read_column_pool: "
+                "\"" + path + "\" is not a column pool file.");
+    }
+    if (header.magic[7] != column_pool_magic[7]) {
+        throw std::runtime_error(
+                "columngenerationsolver::read_column_pool: "
+                "unsupported version of the column pool file format; "
+                "path: \"" + path + "\"; "
+                "version: " + std::to_string((int)header.magic[7]) + "; "
+                "supported version: " + std::to_string((int)column_pool_magic[7]) + ".");
+    }
+    if (header.byte_order != column_pool_byte_order) {
+        throw std::runtime_error(
+                "columngenerationsolver::read_column_pool: "
+                "the column pool file has been written on a platform with a "
+                "different byte order; "
+                "path: \"" + path + "\".");
+    }
+    if (header.number_of_rows != (RowIdx)model.rows.size()) {
+        throw std::invalid_argument(
+                "columngenerationsolver::read_column_pool: "
+                "the column pool file has been written for a model with a "
+                "different number of rows; "
+                "path: \"" + path + "\"; "
+                "number of rows of the file: " + std::to_string(header.number_of_rows) + "; "
+                "number of rows of the model: " + std::to_string((RowIdx)model.rows.size()) + ".");
+    }
+    // The sizes are checked against the size of the file before computing
+    // the expected size, which could overflow otherwise.
+    if (header.number_of_columns < 0
+            || header.number_of_columns > file_size
+            || header.number_of_elements < 0
+            || header.number_of_elements > file_size
+            || header.names_size < 0
+            || header.names_size > file_size
+            || header.extras_size < 0
+            || header.extras_size > file_size
+            || column_pool_file_size(header) != file_size) {
+        throw std::runtime_error(
+                "columngenerationsolver::read_column_pool: "
+                "corrupted column pool file; "
+                "path: \"" + path + "\".");
+    }
+
+    int64_t n = header.number_of_columns;
+    int64_t m = header.number_of_elements;
+    int64_t position = sizeof(header);
+    std::vector<Value> objective_coefficients = read_array<Value>(data, position, n);
+    std::vector<Value> lower_bounds = read_array<Value>(data, position, n);
+    std::vector<Value> upper_bounds = read_array<Value>(data, position, n);
+    std::vector<Value> branching_priorities = read_array<Value>(data, position, n);
+    std::vector<int64_t> element_starts = read_array<int64_t>(data, position, n + 1);
+    std::vector<int64_t> rows = read_array<int64_t>(data, position, m);
+    std::vector<Value> coefficients = read_array<Value>(data, position, m);
+    std::vector<int64_t> name_starts = read_array<int64_t>(data, position, n + 1);
+    std::vector<int64_t> extra_starts = read_array<int64_t>(data, position, n + 1);
+    std::vector<uint8_t> types = read_array<uint8_t>(data, position, n);
+    // The names and the 'extra' fields are bytes, which may be accessed in
+    // place.
+    const char* names = data + position;
+    position += header.names_size;
+    const char* extras = data + position;
+    if (!check_starts(element_starts, n, m)
+            || !check_starts(name_starts, n, header.names_size)
+            || !check_starts(extra_starts, n, header.extras_size)) {
+        throw std::runtime_error(
+                "columngenerationsolver::read_column_pool: "
+                "corrupted column pool file; "
+                "path: \"" + path + "\".");
+    }
+    for (int64_t pos = 0; pos < m; ++pos) {
+        if (rows[pos] < 0 || rows[pos] >= header.number_of_rows) {
+            throw std::runtime_error(
+                    "columngenerationsolver::read_column_pool: "
+                    "corrupted column pool file, invalid row; "
+                    "path: \"" + path + "\"; "
+                    "row: " + std::to_string(rows[pos]) + ".");
+        }
+    }
+
+    std::vector<std::shared_ptr<const Column>> columns;
+    columns.reserve(n);
+    for (int64_t column_id = 0; column_id < n; ++column_id) {
+        auto column = std::make_shared<Column>();
+        column->name.assign(
+                names + name_starts[column_id],
+                names + name_starts[column_id + 1]);
+        column->type = (types[column_id])?
+            VariableType::Integer:
+            VariableType::Continuous;
+        column->lower_bound = lower_bounds[column_id];
+        column->upper_bound = upper_bounds[column_id];
+        column->objective_coefficient = objective_coefficients[column_id];
+        column->branching_priority = branching_priorities[column_id];
+        column->elements.reserve(element_starts[column_id + 1] - element_starts[column_id]);
+        for (int64_t pos = element_starts[column_id];
+                pos < element_starts[column_id + 1];
+                ++pos) {
+            column->elements.push_back({rows[pos], coefficients[pos]});
+        }
+        if (deserialize_extra) {
+            column->extra = deserialize_extra(
+                    extras + extra_starts[column_id],
+                    extra_starts[column_id + 1] - extra_starts[column_id]);
+        }
+        columns.push_back(column);
+    }
+    return columns;
+}
@@ -1,3 +1,20 @@
 #include "columngenerationsolver/commons.hpp"
 
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
 using namespace columngenerationsolver;
+
+Counter columngenerationsolver::peak_resident_set_size()
+{
+#if defined(__linux__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+    // 'ru_maxrss' is in kilobytes on Linux.
+    return (Counter)usage.ru_maxrss * 1024;
+#else
+    return -1;
+#endif
+}
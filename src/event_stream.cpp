@@ -0,0 +1,108 @@
+#include "columngenerationsolver/event_stream.hpp"
+
+using namespace columngenerationsolver;
+
+EventStreamWriter::EventStreamWriter(
+        const std::string& path,
+        double flush_interval):
+    buffer_(1 << 20),
+    flush_interval_(flush_interval),
+    last_flush_time_(std::chrono::steady_clock::now())
+{
+    // The buffer must be set before opening the file to be taken into
+    // account.
+    file_.rdbuf()->pubsetbuf(buffer_.data(), buffer_.size());
+    file_.open(path);
+    if (!file_.good()) {
+        throw std::runtime_error(
+                "columngenerationsolver::EventStreamWriter::EventStreamWriter: "
+                "unable to open file \"" + path + "\".");
+    }
+}
+
+void EventStreamWriter::write(
+        const std::string& name,
+        nlohmann::json event)
+{
+    event["Event"] = name;
+    std::lock_guard<std::mutex> lock(mutex_);
+    file_ << event.dump() << '\n';
+    auto time = std::chrono::steady_clock::now();
+    if (name == "End"
+            || std::chrono::duration<double>(time - last_flush_time_).count()
+            >= flush_interval_) {
+        file_.flush();
+        last_flush_time_ = time;
+    }
+}
+
+void EventStreamWriter::flush()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    file_.flush();
+    last_flush_time_ = std::chrono::steady_clock::now();
+}
+
+BackgroundWriter::BackgroundWriter():
+    thread_(&BackgroundWriter::run, this)
+{
+}
+
+BackgroundWriter::~BackgroundWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    write_submitted_.notify_one();
+    thread_.join();
+}
+
+void BackgroundWriter::submit(std::function<void()> write)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_write_)
+            number_of_skipped_writes_++;
+        pending_write_ = std::move(write);
+    }
+    write_submitted_.notify_one();
+}
+
+void BackgroundWriter::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    write_done_.wait(lock, [this]() { return !pending_write_ && !running_; });
+    if (exception_) {
+        std::exception_ptr exception = exception_;
+        exception_ = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void BackgroundWriter::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        write_submitted_.wait(lock, [this]() { return stop_ || pending_write_; });
+        // The pending write is run even when stopping, so that the last
+        // submitted write is never lost.
+        if (!pending_write_)
+            return;
+        std::function<void()> write = std::move(pending_write_);
+        pending_write_ = nullptr;
+        running_ = true;
+        lock.unlock();
+        std::exception_ptr exception = nullptr;
+        try {
+            write();
+        } catch (...) {
+            exception = std::current_exception();
+        }
+        lock.lock();
+        if (exception)
+            exception_ = exception;
+        running_ = false;
+        write_done_.notify_all();
+    }
+}
@@ -0,0 +1,107 @@
+#include "columngenerationsolver/iteration_trace.hpp"
+
+#include <cmath>
+
+using namespace columngenerationsolver;
+
+IterationTraceWriter::IterationTraceWriter(
+        const std::string& path,
+        IterationTraceFormat format):
+    format_(format),
+    file_(path)
+{
+    if (!file_.good()) {
+        throw std::runtime_error(
+                "columngenerationsolver::IterationTraceWriter::IterationTraceWriter: "
+                "unable to open file \"" + path + "\".");
+    }
+    if (format_ == IterationTraceFormat::Csv) {
+        file_
+            << "NodeId,"
+            << "CuttingPlaneIteration,"
+            << "SolveFeasibility,"
+            << "Iteration,"
+            << "Time,"
+            << "TimeLpSolve,"
+            << "TimeColumnPoolScan,"
+            << "TimePricing,"
+            << "NumberOfColumnPoolHits,"
+            << "NumberOfPricedColumns,"
+            << "NumberOfImprovingColumns,"
+            << "NumberOfMispricings,"
+            << "Alpha,"
+            << "Beta,"
+            << "DualNorm,"
+            << "NumberOfColumnsInLinearSubproblem,"
+            << "RelaxationSolutionValue,"
+            << "Bound"
+            << std::endl;
+    }
+}
+
+namespace
+{
+
+/** Write 'value' as a CSV field, empty if not a number. */
+void write_csv_value(
+        std::ostream& os,
+        double value)
+{
+    if (!std::isnan(value))
+        os << value;
+}
+
+}
+
+void IterationTraceWriter::write(
+        const ColumnGenerationIterationRecord& record)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (format_ == IterationTraceFormat::Ndjson) {
+        // NaN and infinite values are written as 'null'.
+        nlohmann::json json = {
+            {"NodeId", record.node_id},
+            {"CuttingPlaneIteration", record.cutting_plane_iteration},
+            {"SolveFeasibility", record.solve_feasibility},
+            {"Iteration", record.iteration},
+            {"Time", record.time},
+            {"TimeLpSolve", record.time_lpsolve},
+            {"TimeColumnPoolScan", record.time_column_pool_scan},
+            {"TimePricing", record.time_pricing},
+            {"NumberOfColumnPoolHits", record.number_of_column_pool_hits},
+            {"NumberOfPricedColumns", record.number_of_priced_columns},
+            {"NumberOfImprovingColumns", record.number_of_improving_columns},
+            {"NumberOfMispricings", record.number_of_mispricings},
+            {"Alpha", record.alpha},
+            {"Beta", record.beta},
+            {"DualNorm", record.dual_norm},
+            {"NumberOfColumnsInLinearSubproblem", record.number_of_columns_in_linear_subproblem},
+            {"RelaxationSolutionValue", record.relaxation_solution_value},
+            {"Bound", record.bound},
+        };
+        file_ << json.dump() << '\n';
+    } else {
+        file_
+            << record.node_id << ","
+            << record.cutting_plane_iteration << ","
+            << record.solve_feasibility << ","
+            << record.iteration << ","
+            << record.time << ","
+            << record.time_lpsolve << ","
+            << record.time_column_pool_scan << ","
+            << record.time_pricing << ","
+            << record.number_of_column_pool_hits << ","
+            << record.number_of_priced_columns << ","
+            << record.number_of_improving_columns << ","
+            << record.number_of_mispricings << ",";
+        write_csv_value(file_, record.alpha);
+        file_ << ",";
+        write_csv_value(file_, record.beta);
+        file_
+            << "," << record.dual_norm
+            << "," << record.number_of_columns_in_linear_subproblem
+            << "," << record.relaxation_solution_value
+            << "," << record.bound
+            << '\n';
+    }
+}
@@ -49,7 +49,31 @@ public:
             const std::vector<Value>& objective_coefficient,
             const std::vector<Value>& lower_bound,
             const std::vector<Value>& upper_bound) = 0;
+    /**
+     * Change the bounds of an existing column, keeping the rest of the
+     * model (and whatever warm start the solver has) untouched.
+     */
+    virtual void set_column_bounds(
+            ColIdx col,
+            Value lower_bound,
+            Value upper_bound) = 0;
+    /** Change the objective coefficient of an existing column. */
+    virtual void set_objective_coefficient(
+            ColIdx col,
+            Value objective_coefficient) = 0;
     virtual void solve() = 0;
+    /**
+     * Solve with an interior point method, without crossover, up to the
+     * relative optimality tolerance 'relative_tolerance': the duals are
+     * well centered, but neither the duals nor the primal solution are
+     * basic, nor exactly optimal. Solvers without such a method solve
+     * with 'solve'.
+     */
+    virtual void solve_interior_point(Value relative_tolerance)
+    {
+        (void)relative_tolerance;
+        solve();
+    }
     virtual Value objective() const = 0;
     virtual Value dual(RowIdx row) const = 0;
     virtual Value primal(ColIdx col) const = 0;
@@ -132,6 +156,24 @@ public:
                 clp_column_elements.data());
     }
 
+    void set_column_bounds(
+            ColIdx col,
+            Value lower_bound,
+            Value upper_bound)
+    {
+        model_.setColumnBounds(
+                col,
+                (lower_bound != -std::numeric_limits<Value>::infinity())? lower_bound: -COIN_DBL_MAX,
+                (upper_bound != +std::numeric_limits<Value>::infinity())? upper_bound: +COIN_DBL_MAX);
+    }
+
+    void set_objective_coefficient(
+            ColIdx col,
+            Value objective_coefficient)
+    {
+        model_.setObjectiveCoefficient(col, objective_coefficient);
+    }
+
     void solve()
     {
         //model_.writeLp("output");
@@ -142,6 +184,16 @@ public:
         }
     }
 
+    void solve_interior_point(Value)
+    {
+        // The tolerance of the barrier isn't exposed by 'ClpSimplex'.
+        model_.barrier(false);
+        if (model_.isProvenPrimalInfeasible()) {
+            model_.writeLp("output");
+            throw std::runtime_error("Infeasible model (LP written to output.lp)");
+        }
+    }
+
     Value objective() const { return model_.objectiveValue(); }
     Value dual(RowIdx row) const { return model_.dualRowSolution()[row]; }
     Value primal(ColIdx col) const { return model_.getColSolution()[col]; }
@@ -234,12 +286,40 @@ public:
                 highs_column_elements.data());
     }
 
+    void set_column_bounds(
+            ColIdx col,
+            Value lower_bound,
+            Value upper_bound)
+    {
+        model_.changeColBounds(
+                col,
+                (lower_bound != -std::numeric_limits<Value>::infinity())? lower_bound: -1.0e30,
+                (upper_bound != +std::numeric_limits<Value>::infinity())? upper_bound: +1.0e30);
+    }
+
+    void set_objective_coefficient(
+            ColIdx col,
+            Value objective_coefficient)
+    {
+        model_.changeColCost(col, objective_coefficient);
+    }
+
     void solve()
     {
         //model_.writeLp("output");
         model_.run();
     }
 
+    void solve_interior_point(Value relative_tolerance)
+    {
+        model_.setOptionValue("solver", "ipm");
+        model_.setOptionValue("run_crossover", "off");
+        model_.setOptionValue("ipm_optimality_tolerance", relative_tolerance);
+        model_.run();
+        model_.setOptionValue("solver", "choose");
+        model_.setOptionValue("run_crossover", "on");
+    }
+
     Value objective() const { return model_.getObjectiveValue(); }
     Value dual(RowIdx row) const { return model_.getSolution().row_dual[row]; }
     Value primal(ColIdx col) const { return model_.getSolution().col_value[col]; }
@@ -311,12 +391,39 @@ public:
         model_.add(vars_.back());
     }
 
+    void set_column_bounds(
+            ColIdx col,
+            Value lower_bound,
+            Value upper_bound)
+    {
+        vars_[col].setBounds(
+                ((lower_bound != -std::numeric_limits<Value>::infinity())? lower_bound: -IloInfinity),
+                ((upper_bound != std::numeric_limits<Value>::infinity())? upper_bound: IloInfinity));
+    }
+
+    void set_objective_coefficient(
+            ColIdx col,
+            Value objective_coefficient)
+    {
+        obj_.setLinearCoef(vars_[col], objective_coefficient);
+    }
+
     void solve()
     {
         //std::cout << model_ << std::endl;
         cplex_.solve();
     }
 
+    void solve_interior_point(Value relative_tolerance)
+    {
+        cplex_.setParam(IloCplex::Param::RootAlgorithm, IloCplex::Barrier);
+        cplex_.setParam(IloCplex::Param::Barrier::Crossover, IloCplex::NoAlg);
+        cplex_.setParam(IloCplex::Param::Barrier::ConvergeTol, (std::max)(1e-12, relative_tolerance));
+        cplex_.solve();
+        cplex_.setParam(IloCplex::Param::RootAlgorithm, IloCplex::AutoAlg);
+        cplex_.setParam(IloCplex::Param::Barrier::Crossover, IloCplex::AutoAlg);
+    }
+
     Value objective() const { return cplex_.getObjValue(); }
     Value dual(RowIdx row) const { return cplex_.getDual(ranges_[row]); }
     Value primal(ColIdx col) const { return cplex_.getValue(vars_[col]); }
@@ -448,6 +555,28 @@ public:
                 xprs_upper_bounds.data());
     }
 
+    void set_column_bounds(
+            ColIdx col,
+            Value lower_bound,
+            Value upper_bound)
+    {
+        int xprs_indices[2] = {(int)col, (int)col};
+        char xprs_bound_types[2] = {'L', 'U'};
+        double xprs_bounds[2] = {
+            ((lower_bound != -std::numeric_limits<Value>::infinity())? lower_bound: -XPRS_PLUSINFINITY),
+            ((upper_bound != +std::numeric_limits<Value>::infinity())? upper_bound: +XPRS_PLUSINFINITY)};
+        XPRSchgbounds(problem_, 2, xprs_indices, xprs_bound_types, xprs_bounds);
+    }
+
+    void set_objective_coefficient(
+            ColIdx col,
+            Value objective_coefficient)
+    {
+        int xprs_index = col;
+        double xprs_objective_coefficient = objective_coefficient;
+        XPRSchgobj(problem_, 1, &xprs_index, &xprs_objective_coefficient);
+    }
+
     void solve()
     {
         //std::cout << "LinearProgrammingSolverXpress::solve" << std::endl;
@@ -463,6 +592,19 @@ public:
         has_basis_ = true;
     }
 
+    void solve_interior_point(Value relative_tolerance)
+    {
+        if (primals_.empty())
+            return;
+        // No basis to load nor to save.
+        XPRSsetintcontrol(problem_, XPRS_CROSSOVER, 0);
+        XPRSsetdblcontrol(problem_, XPRS_BARGAPSTOP, relative_tolerance);
+        XPRSlpoptimize(problem_, "b");
+        XPRSgetlpsol(problem_, primals_.data(), NULL, duals_.data(), NULL);
+        XPRSsetintcontrol(problem_, XPRS_CROSSOVER, -1);
+        XPRSsetdblcontrol(problem_, XPRS_BARGAPSTOP, 0);
+    }
+
     Value objective() const
     {
         if (primals_.empty())
@@ -554,6 +696,23 @@ public:
                 row_coefficients.data());
     }
 
+    void set_column_bounds(
+            ColIdx col,
+            Value lower_bound,
+            Value upper_bound)
+    {
+        KN_set_var_lobnd(kc_, col, (lower_bound != -std::numeric_limits<Value>::infinity())? lower_bound: -KN_INFINITY);
+        KN_set_var_upbnd(kc_, col, (upper_bound != std::numeric_limits<Value>::infinity())? upper_bound: KN_INFINITY);
+    }
+
+    void set_objective_coefficient(
+            ColIdx col,
+            Value objective_coefficient)
+    {
+        KNINT idx = col;
+        KN_chg_obj_linear_struct(kc_, 1, &idx, &objective_coefficient);
+    }
+
     void solve()
     {
         KN_solve(kc_);
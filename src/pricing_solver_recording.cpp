@@ -0,0 +1,356 @@
+#include "columngenerationsolver/pricing_solver_recording.hpp"
+
+#include <cmath>
+#include <cstring>
+
+using namespace columngenerationsolver;
+
+namespace
+{
+
+/** FNV-1a hash of 'value', combined into 'hash'. */
+void hash_bytes(
+        uint64_t& hash,
+        uint64_t value)
+{
+    for (int byte = 0; byte < 8; ++byte) {
+        hash ^= (value >> (8 * byte)) & 0xff;
+        hash *= 1099511628211ULL;
+    }
+}
+
+void hash_value(
+        uint64_t& hash,
+        Value value)
+{
+    // +0 and -0 compare equal, so they must hash equal.
+    if (value == 0)
+        value = 0;
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    hash_bytes(hash, bits);
+}
+
+/**
+ * JSON representation of 'value'. JSON has no representation for +/-inf,
+ * so they are written as strings (see 'Output::bound_string').
+ */
+nlohmann::json value_to_json(Value value)
+{
+    if (std::isfinite(value))
+        return value;
+    return (value > 0)? "inf": "-inf";
+}
+
+Value value_from_json(const nlohmann::json& json)
+{
+    if (json.is_string())
+        return (json.get<std::string>() == "inf")?
+            std::numeric_limits<Value>::infinity():
+            -std::numeric_limits<Value>::infinity();
+    return json.get<Value>();
+}
+
+nlohmann::json column_to_json(const Column& column)
+{
+    nlohmann::json elements = nlohmann::json::array();
+    for (const LinearTerm& element: column.elements)
+        elements.push_back({element.row, element.coefficient});
+    return {
+        {"Name", column.name},
+        {"Integer", column.type == VariableType::Integer},
+        {"LowerBound", value_to_json(column.lower_bound)},
+        {"UpperBound", value_to_json(column.upper_bound)},
+        {"ObjectiveCoefficient", column.objective_coefficient},
+        {"BranchingPriority", column.branching_priority},
+        {"Elements", elements},
+    };
+}
+
+std::shared_ptr<const Column> column_from_json(const nlohmann::json& json)
+{
+    auto column = std::make_shared<Column>();
+    column->name = json["Name"].get<std::string>();
+    column->type = (json["Integer"].get<bool>())?
+        VariableType::Integer:
+        VariableType::Continuous;
+    column->lower_bound = value_from_json(json["LowerBound"]);
+    column->upper_bound = value_from_json(json["UpperBound"]);
+    column->objective_coefficient = json["ObjectiveCoefficient"].get<Value>();
+    column->branching_priority = json["BranchingPriority"].get<Value>();
+    for (const nlohmann::json& json_element: json["Elements"]) {
+        column->elements.push_back({
+                json_element[0].get<RowIdx>(),
+                json_element[1].get<Value>()});
+    }
+    return column;
+}
+
+}
+
+uint64_t columngenerationsolver::pricing_input_hash(
+        bool solve_feasibility,
+        const std::vector<Value>& duals,
+        const std::vector<std::pair<std::shared_ptr<const Cut>, Value>>& cut_duals,
+        Counter pricing_level)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    hash_bytes(hash, solve_feasibility);
+    hash_bytes(hash, pricing_level);
+    hash_bytes(hash, duals.size());
+    for (Value dual: duals)
+        hash_value(hash, dual);
+    hash_bytes(hash, cut_duals.size());
+    for (const auto& p: cut_duals)
+        hash_value(hash, p.second);
+    return hash;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//////////////////////////// RecordingPricingSolver ////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+RecordingPricingSolver::RecordingPricingSolver(
+        std::unique_ptr<PricingSolver> pricing_solver,
+        const std::string& path):
+    pricing_solver_(std::move(pricing_solver)),
+    file_(path)
+{
+    if (pricing_solver_ == nullptr) {
+        throw std::invalid_argument(
+                "columngenerationsolver::RecordingPricingSolver::RecordingPricingSolver: "
+                "'pricing_solver' must not be null.");
+    }
+    if (!file_.good()) {
+        throw std::runtime_error(
+                "columngenerationsolver::RecordingPricingSolver::RecordingPricingSolver: "
+                "unable to open file \"" + path + "\".");
+    }
+    nlohmann::json json = {
+        {"Type", "Header"},
+        {"NumberOfPricingLevels", pricing_solver_->number_of_pricing_levels()},
+    };
+    file_ << json.dump() << '\n';
+}
+
+nlohmann::json RecordingPricingSolver::column_ids(
+        const std::vector<std::shared_ptr<const Column>>& columns,
+        nlohmann::json& new_columns)
+{
+    nlohmann::json ids = nlohmann::json::array();
+    for (const auto& column: columns) {
+        auto res = column_ids_.insert({column, (Counter)column_ids_.size()});
+        if (res.second) {
+            nlohmann::json json_column = column_to_json(*column);
+            json_column["Id"] = res.first->second;
+            new_columns.push_back(json_column);
+        }
+        ids.push_back(res.first->second);
+    }
+    return ids;
+}
+
+std::vector<std::shared_ptr<const Column>> RecordingPricingSolver::initialize_pricing(
+        const std::vector<std::pair<std::shared_ptr<const Column>, Value>>& fixed_columns,
+        const std::vector<std::shared_ptr<const Cut>>& cuts,
+        const std::vector<std::shared_ptr<const BranchingDecision>>& branching_decisions,
+        Value reduced_cost_fixing_gap)
+{
+    std::vector<std::shared_ptr<const Column>> infeasible_columns
+        = pricing_solver_->initialize_pricing(
+                fixed_columns,
+                cuts,
+                branching_decisions,
+                reduced_cost_fixing_gap);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    nlohmann::json new_columns = nlohmann::json::array();
+    nlohmann::json json = {
+        {"Type", "InitializePricing"},
+        {"InfeasibleColumns", column_ids(infeasible_columns, new_columns)},
+    };
+    json["NewColumns"] = new_columns;
+    file_ << json.dump() << '\n';
+    return infeasible_columns;
+}
+
+PricingSolver::PricingOutput RecordingPricingSolver::solve_pricing(
+        bool solve_feasibility,
+        const std::vector<Value>& duals,
+        const std::vector<std::pair<std::shared_ptr<const Cut>, Value>>& cut_duals,
+        Counter pricing_level,
+        const PricingContext& context)
+{
+    PricingOutput output = pricing_solver_->solve_pricing(
+            solve_feasibility,
+            duals,
+            cut_duals,
+            pricing_level,
+            context);
+
+    uint64_t input_hash = pricing_input_hash(
+            solve_feasibility,
+            duals,
+            cut_duals,
+            pricing_level);
+    std::lock_guard<std::mutex> lock(mutex_);
+    nlohmann::json new_columns = nlohmann::json::array();
+    nlohmann::json json = {
+        {"Type", "SolvePricing"},
+        {"InputHash", input_hash},
+        {"Columns", column_ids(output.columns, new_columns)},
+        {"Overcost", value_to_json(output.overcost)},
+        {"LagrangianColumnValues", output.lagrangian_column_values},
+        {"LagrangianColumnMultiplicities", output.lagrangian_column_multiplicities},
+        {"Interrupted", output.interrupted},
+    };
+    json["NewColumns"] = new_columns;
+    file_ << json.dump() << '\n';
+    return output;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///////////////////////////// ReplayPricingSolver //////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+ReplayPricingSolver::ReplayPricingSolver(
+        const std::string& path,
+        bool strict):
+    path_(path),
+    strict_(strict)
+{
+    std::ifstream file(path);
+    if (!file.good()) {
+        throw std::runtime_error(
+                "columngenerationsolver::ReplayPricingSolver::ReplayPricingSolver: "
+                "unable to open file \"" + path + "\".");
+    }
+
+    std::vector<std::shared_ptr<const Column>> columns;
+    auto read_columns = [&columns](const nlohmann::json& json)
+    {
+        if (!json.contains("NewColumns"))
+            return;
+        for (const nlohmann::json& json_column: json["NewColumns"]) {
+            Counter column_id = json_column["Id"].get<Counter>();
+            if (column_id >= (Counter)columns.size())
+                columns.resize(column_id + 1);
+            columns[column_id] = column_from_json(json_column);
+        }
+    };
+
+    std::string line;
+    Counter line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        if (line.empty())
+            continue;
+        nlohmann::json json = nlohmann::json::parse(line);
+        read_columns(json);
+        std::string type = json["Type"].get<std::string>();
+        if (type == "Header") {
+            number_of_pricing_levels_ = json["NumberOfPricingLevels"].get<Counter>();
+
+        } else if (type == "InitializePricing") {
+            RecordedSubproblem subproblem;
+            for (const nlohmann::json& json_column_id: json["InfeasibleColumns"])
+                subproblem.infeasible_columns.push_back(columns[json_column_id.get<Counter>()]);
+            subproblems_.push_back(subproblem);
+
+        } else if (type == "SolvePricing") {
+            if (subproblems_.empty()) {
+                throw std::runtime_error(
+                        "columngenerationsolver::ReplayPricingSolver::ReplayPricingSolver: "
+                        "call to 'solve_pricing' before any call to 'initialize_pricing'; "
+                        "path: \"" + path + "\"; "
+                        "line: " + std::to_string(line_number) + ".");
+            }
+            RecordedPricing pricing;
+            pricing.input_hash = json["InputHash"].get<uint64_t>();
+            for (const nlohmann::json& json_column_id: json["Columns"])
+                pricing.output.columns.push_back(columns[json_column_id.get<Counter>()]);
+            pricing.output.overcost = value_from_json(json["Overcost"]);
+            pricing.output.lagrangian_column_values
+                = json["LagrangianColumnValues"].get<std::vector<Value>>();
+            if (json.contains("LagrangianColumnMultiplicities")) {
+                pricing.output.lagrangian_column_multiplicities
+                    = json["LagrangianColumnMultiplicities"].get<std::vector<Value>>();
+            }
+            pricing.output.interrupted = json["Interrupted"].get<bool>();
+            subproblems_.back().pricings.push_back(pricing);
+
+        } else {
+            throw std::runtime_error(
+                    "columngenerationsolver::ReplayPricingSolver::ReplayPricingSolver: "
+                    "unknown record type \"" + type + "\"; "
+                    "path: \"" + path + "\"; "
+                    "line: " + std::to_string(line_number) + ".");
+        }
+    }
+}
+
+std::vector<std::shared_ptr<const Column>> ReplayPricingSolver::initialize_pricing(
+        const std::vector<std::pair<std::shared_ptr<const Column>, Value>>&,
+        const std::vector<std::shared_ptr<const Cut>>&,
+        const std::vector<std::shared_ptr<const BranchingDecision>>&,
+        Value)
+{
+    subproblem_pos_++;
+    next_pricing_pos_ = 0;
+    if (subproblem_pos_ >= (Counter)subproblems_.size()) {
+        throw std::runtime_error(
+                "columngenerationsolver::ReplayPricingSolver::initialize_pricing: "
+                "more calls than recorded; "
+                "path: \"" + path_ + "\"; "
+                "number of recorded calls: " + std::to_string(subproblems_.size()) + ".");
+    }
+    return subproblems_[subproblem_pos_].infeasible_columns;
+}
+
+PricingSolver::PricingOutput ReplayPricingSolver::solve_pricing(
+        bool solve_feasibility,
+        const std::vector<Value>& duals,
+        const std::vector<std::pair<std::shared_ptr<const Cut>, Value>>& cut_duals,
+        Counter pricing_level,
+        const PricingContext&)
+{
+    if (subproblem_pos_ == -1) {
+        throw std::logic_error(
+                "columngenerationsolver::ReplayPricingSolver::solve_pricing: "
+                "called before 'initialize_pricing'.");
+    }
+    number_of_calls_++;
+    std::vector<RecordedPricing>& pricings = subproblems_[subproblem_pos_].pricings;
+
+    // Look for a recorded call with the same input.
+    uint64_t input_hash = pricing_input_hash(
+            solve_feasibility,
+            duals,
+            cut_duals,
+            pricing_level);
+    for (RecordedPricing& pricing: pricings) {
+        if (!pricing.served && pricing.input_hash == input_hash) {
+            pricing.served = true;
+            return pricing.output;
+        }
+    }
+
+    number_of_mismatches_++;
+    if (strict_) {
+        throw std::runtime_error(
+                "columngenerationsolver::ReplayPricingSolver::solve_pricing: "
+                "no recorded call with the same input; "
+                "path: \"" + path_ + "\"; "
+                "subproblem: " + std::to_string(subproblem_pos_) + "; "
+                "call: " + std::to_string(number_of_calls_) + ".");
+    }
+    while (next_pricing_pos_ < (Counter)pricings.size()
+            && pricings[next_pricing_pos_].served) {
+        next_pricing_pos_++;
+    }
+    if (next_pricing_pos_ == (Counter)pricings.size())
+        return PricingOutput();
+    RecordedPricing& pricing = pricings[next_pricing_pos_];
+    pricing.served = true;
+    return pricing.output;
+}
@@ -0,0 +1,148 @@
+#include "trace_events.hpp"
+
+#if COLUMNGENERATIONSOLVER_TRACE_EVENTS
+
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace columngenerationsolver;
+
+namespace
+{
+
+struct TraceEvent
+{
+    /** Name. */
+    const char* name;
+
+    /** Start, in microseconds since the start of the recording. */
+    double start;
+
+    /** Duration, in microseconds. */
+    double duration;
+
+    /** Thread. */
+    int thread_id;
+};
+
+/**
+ * Recorder of the trace events of the process.
+ *
+ * The events are buffered and appended to the file every
+ * 'maximum_number_of_buffered_events' events, so that the memory used stays
+ * bounded and that a process killed or crashing loses at most the last
+ * ones. The file uses the JSON array format of the trace events, whose
+ * closing bracket, only written at exit, may be missing.
+ */
+class TraceEventRecorder
+{
+
+public:
+
+    static TraceEventRecorder& instance()
+    {
+        static TraceEventRecorder recorder;
+        return recorder;
+    }
+
+    void record(
+            const char* name,
+            std::chrono::steady_clock::time_point start,
+            std::chrono::steady_clock::time_point end)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = thread_ids_.find(std::this_thread::get_id());
+        if (it == thread_ids_.end()) {
+            it = thread_ids_.insert({
+                    std::this_thread::get_id(),
+                    (int)thread_ids_.size() + 1}).first;
+        }
+        TraceEvent event;
+        event.name = name;
+        event.start = std::chrono::duration<double, std::micro>(start - origin_).count();
+        event.duration = std::chrono::duration<double, std::micro>(end - start).count();
+        event.thread_id = it->second;
+        events_.push_back(event);
+        if (events_.size() >= maximum_number_of_buffered_events)
+            flush();
+    }
+
+    ~TraceEventRecorder()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        flush();
+        if (file_.good())
+            file_ << "\n]" << std::endl;
+    }
+
+private:
+
+    /** Number of events buffered before being written. */
+    static const std::size_t maximum_number_of_buffered_events = 1024;
+
+    TraceEventRecorder():
+        origin_(std::chrono::steady_clock::now())
+    {
+        const char* path = std::getenv("COLUMNGENERATIONSOLVER_TRACE_EVENTS_PATH");
+        file_.open((path != nullptr)? path: "trace_events.json");
+        file_ << "[";
+        events_.reserve(maximum_number_of_buffered_events);
+    }
+
+    /** Write the buffered events. */
+    void flush()
+    {
+        if (file_.good()) {
+            for (const TraceEvent& event: events_) {
+                file_
+                    << ((number_of_written_events_ == 0)? "\n": ",\n")
+                    << "{\"name\":\"" << event.name << "\""
+                    << ",\"cat\":\"columngenerationsolver\""
+                    << ",\"ph\":\"X\""
+                    << ",\"ts\":" << event.start
+                    << ",\"dur\":" << event.duration
+                    << ",\"pid\":1"
+                    << ",\"tid\":" << event.thread_id
+                    << "}";
+                number_of_written_events_++;
+            }
+            file_.flush();
+        }
+        events_.clear();
+    }
+
+    /** Start of the recording. */
+    std::chrono::steady_clock::time_point origin_;
+
+    /** Mutex protecting the attributes below. */
+    std::mutex mutex_;
+
+    /** Id of each thread which recorded an event. */
+    std::unordered_map<std::thread::id, int> thread_ids_;
+
+    /** Events recorded but not written yet. */
+    std::vector<TraceEvent> events_;
+
+    /** File. */
+    std::ofstream file_;
+
+    /** Number of events written. */
+    std::size_t number_of_written_events_ = 0;
+
+};
+
+}
+
+void columngenerationsolver::record_trace_event(
+        const char* name,
+        std::chrono::steady_clock::time_point start,
+        std::chrono::steady_clock::time_point end)
+{
+    TraceEventRecorder::instance().record(name, start, end);
+}
+
+#endif
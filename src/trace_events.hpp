@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * Trace events of the algorithms, in the Chrome trace-event format, to be
+ * opened with chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Only recorded if the library is compiled with
+ * 'COLUMNGENERATIONSOLVER_TRACE_EVENTS' (CMake option of the same name);
+ * otherwise 'COLUMNGENERATIONSOLVER_TRACE_SCOPE' expands to nothing. The
+ * events are written, by batches as they are recorded, to the file given by
+ * the environment variable 'COLUMNGENERATIONSOLVER_TRACE_EVENTS_PATH'
+ * ("trace_events.json" if not set), with one track per thread.
+ */
+
+#if COLUMNGENERATIONSOLVER_TRACE_EVENTS
+
+#include <chrono>
+
+namespace columngenerationsolver
+{
+
+/** Record an event 'name' from 'start' to 'end' on the current thread. */
+void record_trace_event(
+        const char* name,
+        std::chrono::steady_clock::time_point start,
+        std::chrono::steady_clock::time_point end);
+
+/** Record an event from its construction to its destruction. */
+class TraceEventScope
+{
+
+public:
+
+    /** Constructor. */
+    explicit TraceEventScope(const char* name):
+        name_(name),
+        start_(std::chrono::steady_clock::now()) { }
+
+    /** Destructor. */
+    ~TraceEventScope()
+    {
+        record_trace_event(name_, start_, std::chrono::steady_clock::now());
+    }
+
+    TraceEventScope(const TraceEventScope&) = delete;
+    TraceEventScope& operator=(const TraceEventScope&) = delete;
+
+private:
+
+    /** Name of the event. */
+    const char* name_;
+
+    /** Start of the event. */
+    std::chrono::steady_clock::time_point start_;
+
+};
+
+}
+
+#define COLUMNGENERATIONSOLVER_TRACE_CONCATENATE_DETAIL(x, y) x##y
+#define COLUMNGENERATIONSOLVER_TRACE_CONCATENATE(x, y) COLUMNGENERATIONSOLVER_TRACE_CONCATENATE_DETAIL(x, y)
+
+/** Record an event 'name' until the end of the current scope. */
+#define COLUMNGENERATIONSOLVER_TRACE_SCOPE(name) \
+    ::columngenerationsolver::TraceEventScope COLUMNGENERATIONSOLVER_TRACE_CONCATENATE(trace_event_scope_, __LINE__)(name)
+
+#else
+
+#define COLUMNGENERATIONSOLVER_TRACE_SCOPE(name)
+
+#endif
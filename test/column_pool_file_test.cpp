@@ -0,0 +1,205 @@
+#include "columngenerationsolver/column_pool_file.hpp"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <cstdio>
+
+using namespace columngenerationsolver;
+
+namespace
+{
+
+/** Return a model with 'number_of_rows' rows. */
+Model build_model(RowIdx number_of_rows)
+{
+    Model model;
+    for (RowIdx row_id = 0; row_id < number_of_rows; ++row_id) {
+        Row row;
+        row.lower_bound = 1;
+        row.upper_bound = 1;
+        row.coefficient_lower_bound = 0;
+        row.coefficient_upper_bound = 1;
+        model.rows.push_back(row);
+    }
+    return model;
+}
+
+/** Return the columns written in the tests. */
+std::vector<std::shared_ptr<const Column>> build_columns()
+{
+    std::vector<std::shared_ptr<const Column>> columns;
+
+    auto column_1 = std::make_shared<Column>();
+    column_1->name = "x_1";
+    column_1->objective_coefficient = 3.5;
+    column_1->elements = {{0, 1.0}, {2, 2.5}};
+    column_1->branching_priority = 2;
+    column_1->extra = std::make_shared<std::vector<int>>(std::vector<int>{4, 2, 7});
+    columns.push_back(column_1);
+
+    // Column without name, without elements and without extra.
+    auto column_2 = std::make_shared<Column>();
+    column_2->type = VariableType::Continuous;
+    column_2->lower_bound = -std::numeric_limits<Value>::infinity();
+    column_2->objective_coefficient = -1;
+    columns.push_back(column_2);
+
+    auto column_3 = std::make_shared<Column>();
+    column_3->name = "x_3";
+    column_3->lower_bound = 1;
+    column_3->upper_bound = 4;
+    column_3->elements = {{1, -1.0}};
+    column_3->extra = std::make_shared<std::vector<int>>(std::vector<int>{});
+    columns.push_back(column_3);
+
+    return columns;
+}
+
+/** Write the 'extra' field of a column, a vector of ints, if any. */
+std::string serialize_extra(const Column& column)
+{
+    if (column.extra == nullptr)
+        return "";
+    const std::vector<int>& extra = *std::static_pointer_cast<const std::vector<int>>(column.extra);
+    // A leading byte tells an empty vector apart from no extra.
+    return std::string(1, 'v') + std::string(
+            (const char*)extra.data(),
+            extra.size() * sizeof(int));
+}
+
+/** Read the 'extra' field written by 'serialize_extra'. */
+std::shared_ptr<void> deserialize_extra(const char* data, size_t size)
+{
+    if (size == 0)
+        return nullptr;
+    auto extra = std::make_shared<std::vector<int>>((size - 1) / sizeof(int));
+    std::copy(data + 1, data + size, (char*)extra->data());
+    return extra;
+}
+
+/** Return the content of a file. */
+std::string read_file(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::string(
+            std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>());
+}
+
+/** Overwrite a file with 'content'. */
+void write_file(const std::string& path, const std::string& content)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(content.data(), content.size());
+}
+
+}
+
+TEST(ColumnPoolFile, WriteRead)
+{
+    std::string path = "column_pool_file_test_write_read.bin";
+    Model model = build_model(3);
+    std::vector<std::shared_ptr<const Column>> columns = build_columns();
+    write_column_pool(path, model.rows.size(), columns, serialize_extra);
+    std::vector<std::shared_ptr<const Column>> columns_read = read_column_pool(
+            path,
+            model,
+            deserialize_extra);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(columns_read.size(), columns.size());
+    for (size_t column_id = 0; column_id < columns.size(); ++column_id) {
+        const Column& column = *columns[column_id];
+        const Column& column_read = *columns_read[column_id];
+        EXPECT_EQ(column_read.name, column.name);
+        EXPECT_EQ(column_read.type, column.type);
+        EXPECT_EQ(column_read.lower_bound, column.lower_bound);
+        EXPECT_EQ(column_read.upper_bound, column.upper_bound);
+        EXPECT_EQ(column_read.objective_coefficient, column.objective_coefficient);
+        EXPECT_EQ(column_read.branching_priority, column.branching_priority);
+        ASSERT_EQ(column_read.elements.size(), column.elements.size());
+        for (size_t element_pos = 0;
+                element_pos < column.elements.size();
+                ++element_pos) {
+            EXPECT_EQ(column_read.elements[element_pos].row, column.elements[element_pos].row);
+            EXPECT_EQ(column_read.elements[element_pos].coefficient, column.elements[element_pos].coefficient);
+        }
+        if (column.extra == nullptr) {
+            EXPECT_EQ(column_read.extra, nullptr);
+        } else {
+            ASSERT_NE(column_read.extra, nullptr);
+            EXPECT_EQ(
+                    *std::static_pointer_cast<const std::vector<int>>(column_read.extra),
+                    *std::static_pointer_cast<const std::vector<int>>(column.extra));
+        }
+    }
+    EXPECT_EQ(columns_read[0]->upper_bound, std::numeric_limits<Value>::infinity());
+    EXPECT_EQ(columns_read[1]->lower_bound, -std::numeric_limits<Value>::infinity());
+}
+
+TEST(ColumnPoolFile, WriteReadWithoutExtra)
+{
+    std::string path = "column_pool_file_test_without_extra.bin";
+    Model model = build_model(3);
+    write_column_pool(path, model.rows.size(), build_columns());
+    std::vector<std::shared_ptr<const Column>> columns_read = read_column_pool(
+            path,
+            model,
+            deserialize_extra);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(columns_read.size(), 3u);
+    for (const auto& column: columns_read)
+        EXPECT_EQ(column->extra, nullptr);
+    EXPECT_EQ(columns_read[2]->name, "x_3");
+}
+
+TEST(ColumnPoolFile, Truncated)
+{
+    std::string path = "column_pool_file_test_truncated.bin";
+    Model model = build_model(3);
+    write_column_pool(path, model.rows.size(), build_columns(), serialize_extra);
+    std::string content = read_file(path);
+    // Truncated in the header and in the arrays.
+    for (size_t size: {(size_t)0, (size_t)20, content.size() - 1}) {
+        write_file(path, content.substr(0, size));
+        EXPECT_THROW(
+                read_column_pool(path, model, deserialize_extra),
+                std::runtime_error) << "size: " << size;
+    }
+    std::remove(path.c_str());
+}
+
+TEST(ColumnPoolFile, WrongMagic)
+{
+    std::string path = "column_pool_file_test_wrong_magic.bin";
+    Model model = build_model(3);
+    write_column_pool(path, model.rows.size(), build_columns(), serialize_extra);
+    std::string content = read_file(path);
+    content[0] = 'X';
+    write_file(path, content);
+    EXPECT_THROW(
+            read_column_pool(path, model, deserialize_extra),
+            std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(ColumnPoolFile, RowCountMismatch)
+{
+    std::string path = "column_pool_file_test_row_count_mismatch.bin";
+    write_column_pool(path, 3, build_columns(), serialize_extra);
+    EXPECT_THROW(
+            read_column_pool(path, build_model(4), deserialize_extra),
+            std::invalid_argument);
+    std::remove(path.c_str());
+}
+
+TEST(ColumnPoolFile, InvalidRow)
+{
+    std::string path = "column_pool_file_test_invalid_row.bin";
+    EXPECT_THROW(
+            write_column_pool(path, 2, build_columns(), serialize_extra),
+            std::invalid_argument);
+    std::remove(path.c_str());
+}